@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :asset;
+import :traversal;
+
+static std::mutex g_assetLoaderMutex;
+static pragma::datasystem::AssetLoader g_assetLoader = nullptr;
+
+static std::mutex g_assetEntryMutex;
+static std::unordered_map<std::string, std::weak_ptr<pragma::datasystem::AssetEntry>> g_assetEntries;
+static size_t g_assetEntryPruneThreshold = 64;
+
+void pragma::datasystem::set_asset_loader(const AssetLoader &loader)
+{
+	std::scoped_lock lock {g_assetLoaderMutex};
+	g_assetLoader = loader;
+}
+std::shared_ptr<pragma::datasystem::AssetEntry> pragma::datasystem::get_asset_entry(const std::string &path)
+{
+	auto normalizedPath = path;
+	std::replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
+
+	std::scoped_lock lock {g_assetEntryMutex};
+	auto &weakEntry = g_assetEntries[normalizedPath];
+	auto entry = weakEntry.lock();
+	if(entry)
+		return entry;
+	entry = std::make_shared<AssetEntry>(normalizedPath);
+	weakEntry = entry;
+
+	// Drop entries which are no longer referenced by any document
+	if(g_assetEntries.size() >= g_assetEntryPruneThreshold) {
+		std::erase_if(g_assetEntries, [](const auto &pair) { return pair.second.expired(); });
+		g_assetEntryPruneThreshold = std::max<size_t>(g_assetEntries.size() * 2, 64);
+	}
+	return entry;
+}
+std::vector<std::shared_ptr<pragma::datasystem::AssetEntry>> pragma::datasystem::find_unresolved_assets(const Block &block)
+{
+	std::vector<std::shared_ptr<AssetEntry>> assets;
+	std::unordered_set<const AssetEntry *> visited;
+	visit(block, [&assets, &visited](const std::string &key, const AssetReference &value) {
+		auto &entry = value.GetEntry();
+		if(entry->IsResolved() || !visited.insert(entry.get()).second)
+			return;
+		assets.push_back(entry);
+	});
+	return assets;
+}
+void pragma::datasystem::resolve_assets(const std::vector<std::shared_ptr<AssetEntry>> &assets)
+{
+	for(auto &asset : assets)
+		asset->Resolve();
+}
+
+////////////////////////
+
+pragma::datasystem::AssetEntry::AssetEntry(const std::string &path) : path(path) {}
+bool pragma::datasystem::AssetEntry::IsResolved() const { return m_resolved.load(std::memory_order_acquire); }
+std::shared_ptr<void> pragma::datasystem::AssetEntry::Resolve()
+{
+	if(IsResolved())
+		return m_asset;
+	std::scoped_lock lock {m_mutex};
+	if(IsResolved())
+		return m_asset;
+	AssetLoader loader;
+	{
+		std::scoped_lock lockLoader {g_assetLoaderMutex};
+		loader = g_assetLoader;
+	}
+	// Without a loader the asset stays unresolved, so it can still be resolved once a loader has been set
+	if(loader == nullptr)
+		return nullptr;
+	// Failures may be transient (e.g. the asset hasn't been downloaded yet), so the entry stays unresolved and the load is retried on the next call
+	auto asset = loader(path);
+	if(asset == nullptr)
+		return nullptr;
+	m_asset = std::move(asset);
+	m_resolved.store(true, std::memory_order_release);
+	return m_asset;
+}
+
+////////////////////////
+
+pragma::datasystem::AssetReference::AssetReference(Settings &dataSettings, const std::string &value) : Value(dataSettings), m_entry(get_asset_entry(value)), m_path(value) {}
+pragma::datasystem::AssetReference::AssetReference(Settings &dataSettings, const std::shared_ptr<AssetEntry> &entry) : Value(dataSettings), m_entry(entry), m_path(entry->path) {}
+pragma::datasystem::AssetReference *pragma::datasystem::AssetReference::Copy()
+{
+	auto *cpy = new AssetReference(*m_dataSettings, m_entry);
+	cpy->m_path = m_path;
+	return cpy;
+}
+pragma::datasystem::ValueType pragma::datasystem::AssetReference::GetType() const { return ValueType::Texture; }
+std::string pragma::datasystem::AssetReference::GetTypeString() const { return "texture"; }
+size_t pragma::datasystem::AssetReference::GetMemoryUsage() const { return sizeof(*this); }
+const std::string &pragma::datasystem::AssetReference::GetPath() const { return m_path; }
+void pragma::datasystem::AssetReference::SetPath(const std::string &path)
+{
+	m_entry = get_asset_entry(path);
+	m_path = path;
+	MarkChanged();
+}
+const std::shared_ptr<pragma::datasystem::AssetEntry> &pragma::datasystem::AssetReference::GetEntry() const { return m_entry; }
+bool pragma::datasystem::AssetReference::IsResolved() const { return m_entry->IsResolved(); }
+std::shared_ptr<void> pragma::datasystem::AssetReference::Resolve() const { return m_entry->Resolve(); }
+
+std::string pragma::datasystem::AssetReference::GetString() const { return m_path; }
+int pragma::datasystem::AssetReference::GetInt() const { return 0; }
+float pragma::datasystem::AssetReference::GetFloat() const { return 0.f; }
+bool pragma::datasystem::AssetReference::GetBool() const { return false; }
+Color pragma::datasystem::AssetReference::GetColor() const { return colors::White; }
+Vector3 pragma::datasystem::AssetReference::GetVector() const { return {}; }
+Vector2 pragma::datasystem::AssetReference::GetVector2() const { return {}; }
+Vector4 pragma::datasystem::AssetReference::GetVector4() const { return {}; }
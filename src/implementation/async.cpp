@@ -0,0 +1,403 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :core;
+import pragma.filesystem;
+
+// Files are read in chunks of this size, so a single large file does not hold up the I/O thread in one huge read
+static constexpr size_t FILE_READ_CHUNK_SIZE = 64 * 1024;
+
+std::optional<std::vector<uint8_t>> pragma::datasystem::detail::read_file_contents(const std::string &path)
+{
+	auto f = pragma::fs::open_file(path, pragma::fs::FileMode::Read);
+	if(f == nullptr)
+		return {};
+	fs::File fp {f};
+	return read_stream_contents(fp);
+}
+std::vector<uint8_t> pragma::datasystem::detail::read_stream_contents(ufile::IFile &f)
+{
+	std::vector<uint8_t> data;
+	for(;;) {
+		auto offset = data.size();
+		data.resize(offset + FILE_READ_CHUNK_SIZE);
+		auto numRead = f.Read(data.data() + offset, FILE_READ_CHUNK_SIZE);
+		data.resize(offset + numRead);
+		if(numRead < FILE_READ_CHUNK_SIZE)
+			break;
+	}
+	return data;
+}
+
+// Prefetched data which has not been used within this time is discarded, since the file may have changed in the meantime
+static constexpr auto PREFETCH_MAX_AGE = std::chrono::seconds {30};
+// Maximum total size of all prefetched data. If exceeded, the oldest data is discarded first.
+static constexpr size_t PREFETCH_MAX_SIZE = 256 * 1024 * 1024;
+
+namespace pragma::datasystem {
+	struct PrefetchEntry {
+		std::vector<uint8_t> data;
+		std::chrono::steady_clock::time_point time;
+	};
+};
+static std::mutex g_prefetchMutex;
+static std::unordered_map<std::string, pragma::datasystem::PrefetchEntry> g_prefetchedData;
+static size_t g_prefetchedSize = 0;
+// Most recent pending prefetch request for each path. A request which has been superseded or cancelled by the time its data has been read is dropped.
+static std::unordered_map<std::string, uint64_t> g_prefetchRequests;
+static uint64_t g_nextPrefetchRequestId = 0;
+
+static void erase_prefetched_data(std::unordered_map<std::string, pragma::datasystem::PrefetchEntry>::iterator it)
+{
+	g_prefetchedSize -= it->second.data.size();
+	g_prefetchedData.erase(it);
+}
+static uint64_t add_prefetch_request(const std::string &path)
+{
+	std::scoped_lock lock {g_prefetchMutex};
+	auto id = g_nextPrefetchRequestId++;
+	g_prefetchRequests[path] = id;
+	return id;
+}
+// Removes the request if it is still the most recent one for the path, e.g. if the file could not be read
+static void remove_prefetch_request(const std::string &path, uint64_t requestId)
+{
+	std::scoped_lock lock {g_prefetchMutex};
+	auto it = g_prefetchRequests.find(path);
+	if(it != g_prefetchRequests.end() && it->second == requestId)
+		g_prefetchRequests.erase(it);
+}
+static void store_prefetched_data(const std::string &path, uint64_t requestId, std::vector<uint8_t> &&data)
+{
+	std::scoped_lock lock {g_prefetchMutex};
+	auto itRequest = g_prefetchRequests.find(path);
+	if(itRequest == g_prefetchRequests.end() || itRequest->second != requestId)
+		return;
+	g_prefetchRequests.erase(itRequest);
+	if(data.size() > PREFETCH_MAX_SIZE)
+		return;
+
+	auto it = g_prefetchedData.find(path);
+	if(it != g_prefetchedData.end())
+		erase_prefetched_data(it);
+	auto now = std::chrono::steady_clock::now();
+	while(g_prefetchedSize + data.size() > PREFETCH_MAX_SIZE) {
+		auto itOldest = std::min_element(g_prefetchedData.begin(), g_prefetchedData.end(), [](const auto &a, const auto &b) { return a.second.time < b.second.time; });
+		erase_prefetched_data(itOldest);
+	}
+	g_prefetchedSize += data.size();
+	g_prefetchedData[path] = {std::move(data), now};
+}
+std::optional<std::vector<uint8_t>> pragma::datasystem::detail::take_prefetched_data(const std::string &path)
+{
+	std::scoped_lock lock {g_prefetchMutex};
+	auto it = g_prefetchedData.find(path);
+	if(it == g_prefetchedData.end())
+		return {};
+	std::optional<std::vector<uint8_t>> data {};
+	if(std::chrono::steady_clock::now() - it->second.time <= PREFETCH_MAX_AGE)
+		data = std::move(it->second.data);
+	erase_prefetched_data(it);
+	return data;
+}
+void pragma::datasystem::detail::discard_prefetched_data(const std::string &path)
+{
+	std::scoped_lock lock {g_prefetchMutex};
+	g_prefetchRequests.erase(path);
+	auto it = g_prefetchedData.find(path);
+	if(it != g_prefetchedData.end())
+		erase_prefetched_data(it);
+}
+
+////////////////////////
+
+namespace pragma::datasystem {
+	// Two-stage pipeline: A single I/O thread reads queued files into memory and hands them to a pool of parser threads.
+	class AsyncLoader {
+	  public:
+		struct Job {
+			std::string path;
+			LoadOptions options;
+			System::LoadCallback callback;
+			std::promise<std::shared_ptr<Block>> promise;
+			std::vector<uint8_t> data;
+			bool prefetch = false;
+			uint64_t prefetchRequestId = 0;
+		};
+		AsyncLoader();
+		~AsyncLoader();
+		// Completes all queued jobs and tasks and joins the threads. Jobs queued afterwards fail immediately.
+		void Shutdown();
+		void QueueRead(const std::shared_ptr<Job> &job);
+		// Runs the task on one of the parser threads. Tasks take precedence over queued parse jobs.
+		// Returns false if the loader has been shut down, in which case the task is not run.
+		bool QueueTask(std::function<void()> task);
+		static void Complete(Job &job, const std::shared_ptr<Block> &block, std::exception_ptr exception = nullptr);
+	  private:
+		void RunIo();
+		void RunParser();
+
+		std::thread m_ioThread;
+		std::vector<std::thread> m_parserThreads;
+
+		std::mutex m_ioMutex;
+		std::condition_variable m_ioCondition;
+		std::deque<std::shared_ptr<Job>> m_ioQueue;
+
+		std::mutex m_parseMutex;
+		std::condition_variable m_parseCondition;
+		std::deque<std::shared_ptr<Job>> m_parseQueue;
+		std::deque<std::function<void()>> m_taskQueue;
+
+		bool m_shutdown = false;
+	};
+};
+
+pragma::datasystem::AsyncLoader::AsyncLoader()
+{
+	auto numParserThreads = std::max(std::thread::hardware_concurrency() / 2u, 1u);
+	m_parserThreads.reserve(numParserThreads);
+	for(auto i = decltype(numParserThreads) {0u}; i < numParserThreads; ++i)
+		m_parserThreads.emplace_back([this]() { RunParser(); });
+	m_ioThread = std::thread {[this]() { RunIo(); }};
+}
+pragma::datasystem::AsyncLoader::~AsyncLoader() { Shutdown(); }
+void pragma::datasystem::AsyncLoader::Shutdown()
+{
+	{
+		std::scoped_lock lock {m_ioMutex, m_parseMutex};
+		m_shutdown = true;
+	}
+	// Pending jobs are still completed before the threads exit
+	m_ioCondition.notify_all();
+	if(m_ioThread.joinable())
+		m_ioThread.join();
+	m_parseCondition.notify_all();
+	for(auto &t : m_parserThreads) {
+		if(t.joinable())
+			t.join();
+	}
+}
+void pragma::datasystem::AsyncLoader::QueueRead(const std::shared_ptr<Job> &job)
+{
+	{
+		std::scoped_lock lock {m_ioMutex};
+		if(!m_shutdown) {
+			m_ioQueue.push_back(job);
+			m_ioCondition.notify_one();
+			return;
+		}
+	}
+	if(!job->prefetch)
+		Complete(*job, nullptr);
+}
+bool pragma::datasystem::AsyncLoader::QueueTask(std::function<void()> task)
+{
+	{
+		std::scoped_lock lock {m_parseMutex};
+		if(m_shutdown)
+			return false;
+		m_taskQueue.push_back(std::move(task));
+	}
+	m_parseCondition.notify_one();
+	return true;
+}
+void pragma::datasystem::AsyncLoader::Complete(Job &job, const std::shared_ptr<Block> &block, std::exception_ptr exception)
+{
+	// The callback is always invoked, with nullptr if the load has failed. Exceptions thrown by the callback must not escape the loader threads,
+	// so they are forwarded to the future instead.
+	if(job.callback) {
+		try {
+			job.callback(block);
+		}
+		catch(...) {
+			if(!exception)
+				exception = std::current_exception();
+		}
+	}
+	if(exception)
+		job.promise.set_exception(exception);
+	else
+		job.promise.set_value(block);
+}
+void pragma::datasystem::AsyncLoader::RunIo()
+{
+	for(;;) {
+		std::shared_ptr<Job> job;
+		{
+			std::unique_lock lock {m_ioMutex};
+			m_ioCondition.wait(lock, [this]() { return m_shutdown || !m_ioQueue.empty(); });
+			if(m_ioQueue.empty())
+				return;
+			job = std::move(m_ioQueue.front());
+			m_ioQueue.pop_front();
+		}
+
+		if(job->prefetch) {
+			auto data = detail::read_file_contents(job->path);
+			if(data)
+				store_prefetched_data(job->path, job->prefetchRequestId, std::move(*data));
+			else
+				remove_prefetch_request(job->path, job->prefetchRequestId);
+			continue;
+		}
+		// A previous prefetch request for the same file may already have read the data
+		auto data = detail::take_prefetched_data(job->path);
+		if(!data) {
+			data = detail::read_file_contents(job->path);
+			// Any prefetch request which is still pending would only produce outdated data
+			detail::discard_prefetched_data(job->path);
+		}
+		if(!data) {
+			Complete(*job, nullptr);
+			continue;
+		}
+		job->data = std::move(*data);
+		{
+			std::scoped_lock lock {m_parseMutex};
+			m_parseQueue.push_back(std::move(job));
+		}
+		m_parseCondition.notify_one();
+	}
+}
+void pragma::datasystem::AsyncLoader::RunParser()
+{
+	for(;;) {
+		std::shared_ptr<Job> job;
+		std::function<void()> task;
+		{
+			std::unique_lock lock {m_parseMutex};
+			// The I/O thread has already exited by the time the parsers are notified of the shutdown, so no new jobs can arrive afterwards
+			m_parseCondition.wait(lock, [this]() { return m_shutdown || !m_parseQueue.empty() || !m_taskQueue.empty(); });
+			if(!m_taskQueue.empty()) {
+				task = std::move(m_taskQueue.front());
+				m_taskQueue.pop_front();
+			}
+			else if(!m_parseQueue.empty()) {
+				job = std::move(m_parseQueue.front());
+				m_parseQueue.pop_front();
+			}
+			else
+				return;
+		}
+		if(task) {
+			task();
+			continue;
+		}
+
+		std::shared_ptr<Block> block = nullptr;
+		try {
+			ufile::MemoryFile f {job->data.data(), job->data.size()};
+			block = detail::read_data(f, job->options);
+		}
+		catch(...) {
+			job->data = {};
+			Complete(*job, nullptr, std::current_exception());
+			continue;
+		}
+		job->data = {};
+		if(block)
+			register_document(block, job->path);
+		Complete(*job, block);
+	}
+}
+
+static std::mutex g_asyncLoaderMutex;
+static std::shared_ptr<pragma::datasystem::AsyncLoader> g_asyncLoader = nullptr;
+// Set once close() has been called, no new loader may be created afterwards
+static bool g_asyncLoaderShutdown = false;
+// Callers keep the loader alive while using it. Returns nullptr if the loader has been shut down.
+static std::shared_ptr<pragma::datasystem::AsyncLoader> get_async_loader()
+{
+	std::scoped_lock lock {g_asyncLoaderMutex};
+	if(g_asyncLoader == nullptr && !g_asyncLoaderShutdown)
+		g_asyncLoader = std::make_shared<pragma::datasystem::AsyncLoader>();
+	return g_asyncLoader;
+}
+void pragma::datasystem::detail::run_parallel(uint32_t count, const std::function<void(uint32_t)> &task)
+{
+	struct State {
+		std::function<void(uint32_t)> task;
+		uint32_t count = 0;
+		std::atomic<uint32_t> next = 0;
+		std::mutex mutex;
+		std::condition_variable condition;
+		uint32_t numCompleted = 0;
+	};
+	auto state = std::make_shared<State>();
+	state->task = task;
+	state->count = count;
+	auto run = [](State &state) {
+		for(;;) {
+			auto i = state.next.fetch_add(1);
+			if(i >= state.count)
+				return;
+			state.task(i);
+			{
+				std::scoped_lock lock {state.mutex};
+				++state.numCompleted;
+			}
+			state.condition.notify_all();
+		}
+	};
+	// The calling thread works on the items as well, so this can't deadlock even if it is called from a parser thread
+	// while all other parser threads are busy. Helpers which start after all items have been taken return immediately.
+	if(auto loader = (count > 1) ? get_async_loader() : nullptr) {
+		for(uint32_t i = 1; i < count; ++i) {
+			if(!loader->QueueTask([state, run]() { run(*state); }))
+				break;
+		}
+	}
+	run(*state);
+	std::unique_lock lock {state->mutex};
+	state->condition.wait(lock, [&state]() { return state->numCompleted == state->count; });
+}
+void pragma::datasystem::detail::shutdown_async_loader()
+{
+	std::shared_ptr<AsyncLoader> loader = nullptr;
+	{
+		std::scoped_lock lock {g_asyncLoaderMutex};
+		g_asyncLoaderShutdown = true;
+		loader = std::move(g_asyncLoader);
+	}
+	// The threads are joined here rather than in the destructor, since other threads may still hold a reference to the loader.
+	// A parser thread may hold the last one, and it can't join itself.
+	if(loader)
+		loader->Shutdown();
+	loader = nullptr;
+
+	std::scoped_lock lock {g_prefetchMutex};
+	g_prefetchedData.clear();
+	g_prefetchedSize = 0;
+	g_prefetchRequests.clear();
+}
+
+////////////////////////
+
+std::future<std::shared_ptr<pragma::datasystem::Block>> pragma::datasystem::System::LoadDataAsync(const std::string &path, const LoadOptions &options, const LoadCallback &callback)
+{
+	auto job = std::make_shared<AsyncLoader::Job>();
+	job->path = path;
+	job->options = options;
+	job->callback = callback;
+	auto future = job->promise.get_future();
+	auto loader = get_async_loader();
+	if(loader)
+		loader->QueueRead(job);
+	else
+		AsyncLoader::Complete(*job, nullptr);
+	return future;
+}
+void pragma::datasystem::System::PrefetchData(const std::string &path)
+{
+	auto job = std::make_shared<AsyncLoader::Job>();
+	job->path = path;
+	job->prefetch = true;
+	auto loader = get_async_loader();
+	if(!loader)
+		return;
+	job->prefetchRequestId = add_prefetch_request(path);
+	loader->QueueRead(job);
+}
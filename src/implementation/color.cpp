@@ -10,8 +10,21 @@ pragma::datasystem::Color::Color(Settings &dataSettings, const ::Color &value) :
 pragma::datasystem::Color *pragma::datasystem::Color::Copy() { return new Color(*m_dataSettings, m_value); }
 pragma::datasystem::ValueType pragma::datasystem::Color::GetType() const { return ValueType::Color; }
 const Color &pragma::datasystem::Color::GetValue() const { return m_value; }
-void pragma::datasystem::Color::SetValue(const ::Color &value) { m_value = value; }
+void pragma::datasystem::Color::SetValue(const ::Color &value)
+{
+	m_value = value;
+	MarkChanged();
+}
 std::string pragma::datasystem::Color::GetTypeString() const { return "color"; }
+size_t pragma::datasystem::Color::GetMemoryUsage() const { return sizeof(*this); }
+uint64_t pragma::datasystem::Color::ContentHash() const { return detail::hash_components(GetType(), m_value.r, m_value.g, m_value.b, m_value.a); }
+bool pragma::datasystem::Color::Equals(const Value &other) const
+{
+	if(typeid(other) != typeid(*this))
+		return false;
+	auto &otherValue = static_cast<const Color &>(other).m_value;
+	return m_value.r == otherValue.r && m_value.g == otherValue.g && m_value.b == otherValue.b && m_value.a == otherValue.a;
+}
 
 std::string pragma::datasystem::Color::GetString() const
 {
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :core;
+
+// Distinguishes empty blocks from empty containers and values
+static constexpr uint64_t BLOCK_HASH_SEED = 0x626c6f636bull;
+static constexpr uint64_t CONTAINER_HASH_SEED = 0x636f6e7461696e6572ull;
+
+// splitmix64 finalizer, used to spread entry hashes before they're summed up
+static uint64_t mix_hash(uint64_t hash)
+{
+	hash ^= hash >> 30;
+	hash *= 0xbf58476d1ce4e5b9ull;
+	hash ^= hash >> 27;
+	hash *= 0x94d049bb133111ebull;
+	hash ^= hash >> 31;
+	return hash;
+}
+
+uint64_t pragma::datasystem::detail::hash_string(const std::string_view &str)
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	for(auto c : str) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+uint64_t pragma::datasystem::detail::hash_combine(uint64_t seed, uint64_t hash) { return seed ^ (hash + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)); }
+
+////////////////////////
+
+bool pragma::datasystem::Base::InvalidateCache() { return false; }
+uint64_t pragma::datasystem::Base::ContentHash() const { return 0; }
+void pragma::datasystem::Base::MarkChanged()
+{
+	// Serialized fragments only contain the lines of their own block, so only the blocks which hold this object have to be serialized again
+	if(IsBlock())
+		static_cast<Block *>(this)->m_serializedFragment = nullptr;
+	else {
+		ForEachParent([](Base &parent) {
+			if(parent.IsBlock())
+				static_cast<Block &>(parent).m_serializedFragment = nullptr;
+		});
+	}
+	InvalidateCache();
+	InvalidateAncestors();
+}
+void pragma::datasystem::Base::InvalidateAncestors()
+{
+	// If a parent has nothing cached, none of its ancestors can have anything cached either
+	ForEachParent([](Base &parent) {
+		if(parent.InvalidateCache())
+			parent.InvalidateAncestors();
+	});
+}
+
+bool pragma::datasystem::Block::InvalidateCache()
+{
+	auto cached = m_contentHashValid;
+	m_contentHashValid = false;
+	return cached;
+}
+uint64_t pragma::datasystem::Block::ContentHash() const
+{
+	if(m_contentHashValid)
+		return m_contentHash;
+	// The entries of a block are unordered, so the entry hashes are combined in an order-independent way
+	uint64_t entryHash = 0;
+	for(auto &&[key, data] : GetEntryRange())
+		entryHash += mix_hash(detail::hash_combine(detail::hash_string(key), data.ContentHash()));
+	m_contentHash = detail::hash_combine(detail::hash_combine(BLOCK_HASH_SEED, m_data.size()), entryHash);
+	m_contentHashValid = true;
+	return m_contentHash;
+}
+
+static bool data_equals(const pragma::datasystem::Base &a, const pragma::datasystem::Base &b)
+{
+	using namespace pragma::datasystem;
+	if(a.IsBlock())
+		return b.IsBlock() && static_cast<const Block &>(a).Equals(static_cast<const Block &>(b));
+	if(a.IsContainer()) {
+		if(!b.IsContainer() || a.ContentHash() != b.ContentHash())
+			return false;
+		auto blocksA = static_cast<const Container &>(a).GetBlockRange();
+		auto blocksB = static_cast<const Container &>(b).GetBlockRange();
+		return std::ranges::equal(blocksA, blocksB, [](const Block &blockA, const Block &blockB) { return blockA.Equals(blockB); });
+	}
+	if(!a.IsValue() || !b.IsValue())
+		return false;
+	return static_cast<const Value &>(a).Equals(static_cast<const Value &>(b));
+}
+bool pragma::datasystem::Block::Equals(const Block &other) const
+{
+	if(this == &other)
+		return true;
+	if(m_data.size() != other.m_data.size() || ContentHash() != other.ContentHash())
+		return false;
+	// Matching hashes are only verified to rule out collisions
+	for(auto &pair : m_data) {
+		auto it = other.m_data.find(pair.first);
+		if(it == other.m_data.end() || !data_equals(*pair.second, *it->second))
+			return false;
+	}
+	return true;
+}
+
+bool pragma::datasystem::Container::InvalidateCache()
+{
+	auto cached = m_contentHashValid;
+	m_contentHashValid = false;
+	return cached;
+}
+uint64_t pragma::datasystem::Container::ContentHash() const
+{
+	if(m_contentHashValid)
+		return m_contentHash;
+	auto hash = detail::hash_combine(CONTAINER_HASH_SEED, m_dataBlocks.size());
+	for(auto &block : GetBlockRange())
+		hash = detail::hash_combine(hash, block.ContentHash());
+	m_contentHash = hash;
+	m_contentHashValid = true;
+	return m_contentHash;
+}
+
+uint64_t pragma::datasystem::Value::ContentHash() const { return detail::hash_combine(detail::hash_string(GetTypeString()), detail::hash_string(GetString())); }
+bool pragma::datasystem::Value::Equals(const Value &other) const { return GetType() == other.GetType() && GetTypeString() == other.GetTypeString() && GetString() == other.GetString(); }
+
+uint64_t pragma::datasystem::String::ContentHash() const { return detail::hash_combine(detail::hash_string(GetTypeString()), detail::hash_string(GetValue())); }
+bool pragma::datasystem::String::Equals(const Value &other) const { return typeid(other) == typeid(*this) && static_cast<const String &>(other).m_value == m_value; }
+
+uint64_t pragma::datasystem::Int::ContentHash() const { return detail::hash_components(GetType(), m_value); }
+bool pragma::datasystem::Int::Equals(const Value &other) const { return typeid(other) == typeid(*this) && static_cast<const Int &>(other).m_value == m_value; }
+
+uint64_t pragma::datasystem::Float::ContentHash() const { return detail::hash_components(GetType(), m_value); }
+bool pragma::datasystem::Float::Equals(const Value &other) const { return typeid(other) == typeid(*this) && detail::bitwise_equal(static_cast<const Float &>(other).m_value, m_value); }
+
+uint64_t pragma::datasystem::Bool::ContentHash() const { return detail::hash_components(GetType(), m_value); }
+bool pragma::datasystem::Bool::Equals(const Value &other) const { return typeid(other) == typeid(*this) && static_cast<const Bool &>(other).m_value == m_value; }
@@ -10,86 +10,151 @@ module pragma.datasystem;
 import :core;
 import pragma.filesystem;
 
-static pragma::datasystem::ValueTypeMap *g_DataValueFactoryMap = nullptr;
-
-static pragma::datasystem::ValueTypeMap map;
-void pragma::datasystem::close() { map = {}; }
-
-std::shared_ptr<pragma::datasystem::Settings> pragma::datasystem::create_data_settings(const std::unordered_map<std::string, std::string> &enums) { return std::make_shared<Settings>(enums); }
-void pragma::datasystem::register_data_value_type(const std::string &type, const std::function<Value *(Settings &, const std::string &)> &factory)
+void pragma::datasystem::close()
 {
-	auto ltype = type;
-	pragma::string::to_lower(ltype);
-	if(g_DataValueFactoryMap == nullptr) {
-		g_DataValueFactoryMap = &map;
-	}
-	g_DataValueFactoryMap->AddFactory(ltype, factory);
+	detail::shutdown_async_loader();
+	get_default_value_type_registry()->Clear();
 }
-pragma::datasystem::ValueTypeMap *pragma::datasystem::get_data_value_type_map() { return g_DataValueFactoryMap; }
 
-void pragma::datasystem::ValueTypeMap::AddFactory(const std::string &name, const std::function<Value *(Settings &, const std::string &)> &factory)
+std::shared_ptr<pragma::datasystem::Settings> pragma::datasystem::create_data_settings(const std::unordered_map<std::string, std::string> &enums, const std::shared_ptr<ValueTypeRegistry> &typeRegistry)
 {
-	auto lname = name;
-	pragma::string::to_lower(lname);
-	m_factories.insert(decltype(m_factories)::value_type(lname, factory));
+	return create_data_settings(std::make_shared<const EnumTable>(enums), typeRegistry);
 }
-
-std::function<pragma::datasystem::Value *(pragma::datasystem::Settings &, const std::string &)> pragma::datasystem::ValueTypeMap::FindFactory(const std::string &name)
+std::shared_ptr<pragma::datasystem::Settings> pragma::datasystem::create_data_settings(const std::shared_ptr<const EnumTable> &enumTable, const std::shared_ptr<ValueTypeRegistry> &typeRegistry, const std::shared_ptr<StringPool> &stringPool)
 {
-	auto it = m_factories.find(name);
-	if(it == m_factories.end())
-		return nullptr;
-	return it->second;
+	return std::make_shared<Settings>(enumTable ? enumTable : std::make_shared<const EnumTable>(), typeRegistry ? typeRegistry : get_default_value_type_registry(), stringPool);
 }
+void pragma::datasystem::register_data_value_type(const std::string &type, const ValueTypeInfo::FactoryFunction &factory) { get_default_value_type_registry()->Register(type, factory); }
+void pragma::datasystem::register_base_types() { get_default_value_type_registry()->RegisterBaseTypes(); }
 
-void pragma::datasystem::register_base_types()
-{
-	register_data_value_type<Bool>("bool");
-	register_data_value_type<Float>("float");
-	register_data_value_type<Int>("int");
-	register_data_value_type<String>("string");
-
-	register_data_value_type<Vector>("vector");
-	register_data_value_type<Vector2>("vector2");
-	register_data_value_type<Vector4>("vector4");
+////////////////////////
 
-	register_data_value_type<Color>("color");
+// Parses plain decimal literals (e.g. '1.5' or '-2e3'), which make up the vast majority of values and don't require the expression parser
+static std::optional<float> parse_float_literal(std::string_view str)
+{
+	if(!str.empty() && str.front() == '+')
+		str.remove_prefix(1);
+	// 'inf' and 'nan' are left to the expression parser
+	if(str.empty() || (!std::isdigit(static_cast<unsigned char>(str.back())) && str.back() != '.'))
+		return {};
+	float value;
+	auto *end = str.data() + str.size();
+	auto result = std::from_chars(str.data(), end, value, std::chars_format::general);
+	if(result.ec != std::errc {} || result.ptr != end)
+		return {};
+	return value;
 }
 
-////////////////////////
-
 class pragma::datasystem::Settings : public std::enable_shared_from_this<Settings> {
   public:
-	Settings(const std::unordered_map<std::string, std::string> &enums)
+	Settings(const std::shared_ptr<const EnumTable> &enumTable, const std::shared_ptr<ValueTypeRegistry> &typeRegistry, const std::shared_ptr<StringPool> &stringPool)
+	    : m_enumTable(enumTable), m_typeRegistry(typeRegistry), m_stringPool(stringPool)
 	{
-		exprtk::symbol_table<float> fSymbolTable {};
-		for(auto &pair : enums)
-			fSymbolTable.add_constant(pair.first, pragma::util::to_float(pair.second));
-		m_expression.register_symbol_table(fSymbolTable);
 	}
 	bool ParseExpression(const std::string &expression, float &outResult)
 	{
-		auto r = m_parser.compile(expression, m_expression);
-		if(r)
-			outResult = m_expression.value();
-		return r;
+		auto value = EvaluateExpression(expression);
+		if(value)
+			outResult = *value;
+		return value.has_value();
 	}
 	bool ParseExpression(const std::string &expression, int32_t &outResult)
 	{
-		auto r = m_parser.compile(expression, m_expression);
-		if(r)
-			outResult = pragma::math::round(m_expression.value());
-		return r;
+		// Integer literals and enum flag combinations are evaluated in integer arithmetic, which keeps values above 2^24 exact
+		if(auto value = m_enumTable->Evaluate(expression)) {
+			outResult = static_cast<int32_t>(*value);
+			return true;
+		}
+		auto value = EvaluateExpression(expression);
+		if(value)
+			outResult = pragma::math::round(*value);
+		return value.has_value();
 	}
+	const EnumTable &GetEnumTable() const { return *m_enumTable; }
+	const ValueTypeRegistry &GetValueTypeRegistry() const { return *m_typeRegistry; }
+	StringPool *GetStringPool() const { return m_stringPool.get(); }
   private:
-	exprtk::expression<float> m_expression = {};
-	exprtk::parser<float> m_parser = {};
+	struct ExpressionParser {
+		exprtk::expression<float> expression = {};
+		exprtk::parser<float> parser = {};
+	};
+	// Expression parsers can't be shared between threads, so each concurrent evaluation takes its own parser from the pool.
+	// Parsers (and their symbol tables) are only created once an expression actually needs them.
+	std::optional<float> EvaluateExpression(const std::string &expression)
+	{
+		// Literals are parsed without taking a parser from the pool, so parallel parsing doesn't contend on the mutex for every value
+		if(auto value = parse_float_literal(expression))
+			return value;
+		std::unique_ptr<ExpressionParser> parser = nullptr;
+		{
+			std::scoped_lock lock {m_expressionMutex};
+			if(!m_expressionParsers.empty()) {
+				parser = std::move(m_expressionParsers.back());
+				m_expressionParsers.pop_back();
+			}
+		}
+		if(parser == nullptr) {
+			parser = std::make_unique<ExpressionParser>();
+			exprtk::symbol_table<float> fSymbolTable {};
+			for(auto &entry : m_enumTable->GetEntries())
+				fSymbolTable.add_constant(entry.name, entry.isInteger ? static_cast<float>(entry.intValue) : pragma::util::to_float(entry.value));
+			parser->expression.register_symbol_table(fSymbolTable);
+		}
+		std::optional<float> result {};
+		if(parser->parser.compile(expression, parser->expression))
+			result = parser->expression.value();
+		std::scoped_lock lock {m_expressionMutex};
+		m_expressionParsers.push_back(std::move(parser));
+		return result;
+	}
+	std::shared_ptr<const EnumTable> m_enumTable;
+	std::shared_ptr<ValueTypeRegistry> m_typeRegistry;
+	std::shared_ptr<StringPool> m_stringPool;
+	std::mutex m_expressionMutex;
+	std::vector<std::unique_ptr<ExpressionParser>> m_expressionParsers;
 };
 
 pragma::datasystem::Base::Base(Settings &dataSettings) : m_dataSettings(dataSettings.shared_from_this()) {}
+pragma::datasystem::Base::Base(const Base &other) : std::enable_shared_from_this<Base>(other), m_dataSettings(other.m_dataSettings) {}
+pragma::datasystem::Base &pragma::datasystem::Base::operator=(const Base &other)
+{
+	m_dataSettings = other.m_dataSettings;
+	return *this;
+}
+void pragma::datasystem::Base::AddParent(Base &parent)
+{
+	if(m_parent == nullptr) {
+		m_parent = &parent;
+		return;
+	}
+	if(m_sharedParents == nullptr)
+		m_sharedParents = std::make_unique<std::vector<Base *>>();
+	m_sharedParents->push_back(&parent);
+}
+void pragma::datasystem::Base::RemoveParent(Base &parent)
+{
+	// An object may have been added to the same parent multiple times, so only one reference is removed
+	if(m_parent == &parent) {
+		m_parent = nullptr;
+		if(m_sharedParents && !m_sharedParents->empty()) {
+			m_parent = m_sharedParents->back();
+			m_sharedParents->pop_back();
+		}
+	}
+	else if(m_sharedParents) {
+		auto it = std::find(m_sharedParents->begin(), m_sharedParents->end(), &parent);
+		if(it != m_sharedParents->end())
+			m_sharedParents->erase(it);
+	}
+	if(m_sharedParents && m_sharedParents->empty())
+		m_sharedParents = nullptr;
+}
 const pragma::datasystem::Settings &pragma::datasystem::Base::GetDataSettings() const { return const_cast<Base *>(this)->GetDataSettings(); }
 pragma::datasystem::Settings &pragma::datasystem::Base::GetDataSettings() { return *m_dataSettings; }
-pragma::datasystem::Base *pragma::datasystem::Base::Copy() { return new Base(*this); }
+pragma::datasystem::Base *pragma::datasystem::Base::Copy()
+{
+	return new Base(*this);
+}
 bool pragma::datasystem::Base::IsBlock() const { return false; }
 bool pragma::datasystem::Base::IsContainer() const { return false; }
 pragma::datasystem::Base::~Base() {}
@@ -98,21 +163,19 @@ std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::Base::GetBlock(co
 
 ////////////////////////
 
-pragma::datasystem::Iterator::Iterator(Base &data) : m_target(data), m_index(0) {}
+pragma::datasystem::Iterator::Iterator(Base &data) : m_index(0)
+{
+	if(data.IsBlock())
+		m_block = &static_cast<Block &>(data);
+	else if(data.IsContainer())
+		m_container = &static_cast<Container &>(data);
+}
 
-bool pragma::datasystem::Iterator::IsValid()
+bool pragma::datasystem::Iterator::IsValid() const
 {
-	if(m_target.IsBlock()) {
-		if(m_index > 0)
-			return false;
-		return true;
-	}
-	if(!m_target.IsContainer())
-		return false;
-	auto &container = static_cast<Container &>(m_target);
-	if(m_index >= container.GetBlockCount())
-		return false;
-	return true;
+	if(m_block)
+		return m_index == 0;
+	return m_container && m_index < m_container->GetBlockCount();
 }
 
 void pragma::datasystem::Iterator::operator++(int) { m_index++; }
@@ -121,9 +184,9 @@ pragma::datasystem::Block *pragma::datasystem::Iterator::get()
 {
 	if(!IsValid())
 		return nullptr;
-	if(m_target.IsBlock())
-		return &static_cast<Block &>(m_target);
-	return static_cast<Container &>(m_target).GetBlock(m_index).get();
+	if(m_block)
+		return m_block;
+	return m_container->GetBlocks()[m_index].get();
 }
 
 pragma::datasystem::Block *pragma::datasystem::Iterator::operator->() { return get(); }
@@ -131,7 +194,13 @@ pragma::datasystem::Block *pragma::datasystem::Iterator::operator->() { return g
 ////////////////////////
 
 pragma::datasystem::Block::Block(Settings &dataSettings) : Base(dataSettings) {}
-pragma::datasystem::Block::~Block() { m_data.clear(); }
+pragma::datasystem::Block::~Block()
+{
+	// Children may outlive their parent if they are still referenced elsewhere
+	for(auto &pair : m_data)
+		pair.second->RemoveParent(*this);
+	m_data.clear();
+}
 std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::Block::GetBlock(const std::string_view &name, unsigned int id)
 {
 	auto &data = GetValue(name);
@@ -147,14 +216,18 @@ void pragma::datasystem::Block::RemoveValue(const std::string &key)
 	auto it = m_data.find(key);
 	if(it == m_data.end())
 		return;
+	it->second->RemoveParent(*this);
 	m_data.erase(it);
+	MarkChanged();
 }
 void pragma::datasystem::Block::DetachData(Base &val)
 {
 	auto it = std::find_if(m_data.begin(), m_data.end(), [&val](const std::pair<std::string, std::shared_ptr<Base>> &pair) { return pair.second.get() == &val; });
 	if(it == m_data.end())
 		return;
+	it->second->RemoveParent(*this);
 	m_data.erase(it);
+	MarkChanged();
 }
 pragma::datasystem::Block *pragma::datasystem::Block::Copy()
 {
@@ -163,53 +236,92 @@ pragma::datasystem::Block *pragma::datasystem::Block::Copy()
 		cpy->AddData(it->first, std::shared_ptr<Base>(it->second->Copy()));
 	return cpy;
 }
-std::string pragma::datasystem::Block::ToString(const std::optional<std::string> &rootIdentifier, uint8_t tabDepth) const
+// Writes the entries of a block. Child blocks are written through 'writeChild', which is called between the opening and closing brace.
+static void write_entries(const pragma::datasystem::Block &block, std::ostream &os, uint8_t tabDepth, const std::function<void(const pragma::datasystem::Block &)> &writeChild)
+{
+	using namespace pragma::datasystem;
+	std::string t(tabDepth, '\t');
+	auto writeBlock = [&os, &t, &writeChild](const std::string &key, const Block &child) {
+		os << t << "\"" << key << "\"\n" << t << "{\n";
+		writeChild(child);
+		os << t << "}\n";
+	};
+	for(auto &&[key, data] : block.GetEntryRange()) {
+		if(data.IsBlock()) {
+			writeBlock(key, static_cast<Block &>(data));
+			continue;
+		}
+		if(data.IsContainer()) {
+			// Blocks with the same key are merged into a container when the data is loaded, so each block is written separately
+			for(auto &child : static_cast<Container &>(data).GetBlockRange())
+				writeBlock(key, child);
+			continue;
+		}
+		auto *dsValue = dynamic_cast<Value *>(&data);
+		if(dsValue == nullptr)
+			throw std::invalid_argument {"Unexpected data set type!"};
+		os << t << "$" << dsValue->GetTypeString() << " \"" << key << "\" \"" << dsValue->GetString() << "\"\n";
+	}
+}
+void pragma::datasystem::Block::WriteData(std::ostream &os, uint8_t tabDepth) const
+{
+	write_entries(*this, os, tabDepth, [&os, tabDepth](const Block &child) { child.WriteData(os, tabDepth + 1); });
+}
+const pragma::datasystem::Block::SerializedFragment &pragma::datasystem::Block::GetSerializedFragment(uint8_t tabDepth) const
+{
+	if(m_serializedFragment && m_serializedFragment->tabDepth == tabDepth)
+		return *m_serializedFragment;
+	auto fragment = std::unique_ptr<SerializedFragment> {new SerializedFragment {}};
+	fragment->tabDepth = tabDepth;
+	std::stringstream ss;
+	write_entries(*this, ss, tabDepth, [&ss, &fragment](const Block &child) {
+		fragment->segments.push_back({ss.str(), &child});
+		ss.str("");
+	});
+	auto tail = ss.str();
+	if(!tail.empty())
+		fragment->segments.push_back({std::move(tail), nullptr});
+	m_serializedFragment = std::move(fragment);
+	return *m_serializedFragment;
+}
+void pragma::datasystem::Block::WriteCachedData(std::ostream &os, uint8_t tabDepth) const
+{
+	// The child pointers stay valid as long as the fragment exists, since removing or replacing a child discards the fragment
+	for(auto &segment : GetSerializedFragment(tabDepth).segments) {
+		os << segment.text;
+		if(segment.child)
+			segment.child->WriteCachedData(os, tabDepth + 1);
+	}
+}
+std::string pragma::datasystem::Block::Serialize(const std::optional<std::string> &rootIdentifier, uint8_t tabDepth, bool useCache) const
 {
 	std::stringstream ss;
 	if(rootIdentifier.has_value()) {
 		ss << "\"" << *rootIdentifier << "\"\n{\n";
 		++tabDepth;
 	}
-
-	std::string t(tabDepth, '\t');
-	std::function<void(const Block &, const std::string &)> fIterateDataBlock = nullptr;
-	fIterateDataBlock = [&ss, &fIterateDataBlock](const Block &block, const std::string &t) {
-		auto *data = block.GetData();
-		if(data == nullptr)
-			return;
-		for(auto &pair : *data) {
-			if(pair.second->IsBlock()) {
-				auto &block = static_cast<Block &>(*pair.second);
-				ss << t << "\"" << pair.first << "\"\n" << t << "{\n";
-				fIterateDataBlock(block, t + '\t');
-				ss << t << "}\n";
-				continue;
-			}
-			if(pair.second->IsContainer()) {
-				auto &container = static_cast<Container &>(*pair.second);
-				ss << t << "\"" << pair.first << "\"\n" << t << "{\n";
-				for(auto &block : container.GetBlocks()) {
-					if(block->IsContainer() || block->IsBlock())
-						throw std::invalid_argument {"Data set block may only contain values!"};
-					auto *dsValue = dynamic_cast<Value *>(pair.second.get());
-					if(dsValue == nullptr)
-						throw std::invalid_argument {"Unexpected data set type!"};
-					ss << t << "\t\"" << dsValue->GetString() << "\"\n";
-				}
-				ss << t << "}\n";
-				continue;
-			}
-			auto *dsValue = dynamic_cast<Value *>(pair.second.get());
-			if(dsValue == nullptr)
-				throw std::invalid_argument {"Unexpected data set type!"};
-			ss << t << "$" << dsValue->GetTypeString() << " \"" << pair.first << "\" \"" << dsValue->GetString() << "\"\n";
-		}
-	};
-	fIterateDataBlock(*this, t);
+	if(useCache)
+		WriteCachedData(ss, tabDepth);
+	else
+		WriteData(ss, tabDepth);
 	if(rootIdentifier.has_value())
 		ss << "}\n";
 	return ss.str();
 }
+std::string pragma::datasystem::Block::ToString(const std::optional<std::string> &rootIdentifier, uint8_t tabDepth) const { return Serialize(rootIdentifier, tabDepth, false); }
+std::string pragma::datasystem::Block::ToStringIncremental(const std::optional<std::string> &rootIdentifier, uint8_t tabDepth) const { return Serialize(rootIdentifier, tabDepth, true); }
+void pragma::datasystem::Block::ClearSerializationCache()
+{
+	for(auto &&[key, data] : GetEntryRange()) {
+		if(data.IsBlock())
+			static_cast<Block &>(data).ClearSerializationCache();
+		else if(data.IsContainer()) {
+			for(auto &child : static_cast<Container &>(data).GetBlockRange())
+				child.ClearSerializationCache();
+		}
+	}
+	m_serializedFragment = nullptr;
+}
 bool pragma::datasystem::Block::IsBlock() const { return true; }
 const pragma::datasystem::Block::DataMap *pragma::datasystem::Block::GetData() const { return &m_data; }
 void pragma::datasystem::Block::AddData(const std::string &name, const std::shared_ptr<Base> &data)
@@ -219,11 +331,16 @@ void pragma::datasystem::Block::AddData(const std::string &name, const std::shar
 	auto it = m_data.find(lname);
 	if(it == m_data.end()) {
 		data->m_dataSettings = m_dataSettings;
+		data->AddParent(*this);
 		m_data[lname] = data;
+		MarkChanged();
 		return;
 	}
 	if(!data->IsBlock()) {
+		it->second->RemoveParent(*this);
+		data->AddParent(*this);
 		it->second = data;
+		MarkChanged();
 		return;
 	}
 	if(it->second->IsContainer()) {
@@ -231,9 +348,12 @@ void pragma::datasystem::Block::AddData(const std::string &name, const std::shar
 		return;
 	}
 	auto container = std::shared_ptr<Container>(new Container(*m_dataSettings));
+	container->AddParent(*this);
+	it->second->RemoveParent(*this);
 	container->AddData(std::static_pointer_cast<Block>(it->second));
 	container->AddData(std::static_pointer_cast<Block>(data));
 	it->second = container;
+	MarkChanged();
 }
 const std::shared_ptr<pragma::datasystem::Base> &pragma::datasystem::Block::GetValue(const std::string_view &key) const
 {
@@ -266,13 +386,21 @@ void pragma::datasystem::Block::AddValue(const std::string &name, const Vector3
 void pragma::datasystem::Block::AddValue(const std::string &name, const ::Vector4 &value) { AddValue<::Vector4, Vector4>(name, value, "vector4"); }
 std::shared_ptr<pragma::datasystem::Base> pragma::datasystem::Block::AddValue(const std::string &type, const std::string &name, const std::string &value)
 {
-	static std::shared_ptr<Base> nptr = nullptr;
-	auto ltype = type;
-	pragma::string::to_lower(ltype);
-	auto factory = g_DataValueFactoryMap->FindFactory(ltype);
-	if(factory == nullptr)
-		return nptr;
-	auto data = std::static_pointer_cast<Base>(std::shared_ptr<Value>(factory(*m_dataSettings, value)));
+	auto *typeInfo = m_dataSettings->GetValueTypeRegistry().FindType(type);
+	if(typeInfo == nullptr)
+		return nullptr;
+	return AddValue(*typeInfo, name, value);
+}
+std::shared_ptr<pragma::datasystem::Base> pragma::datasystem::Block::AddValue(ValueTypeId type, const std::string &name, const std::string &value)
+{
+	auto *typeInfo = m_dataSettings->GetValueTypeRegistry().GetType(type);
+	if(typeInfo == nullptr)
+		return nullptr;
+	return AddValue(*typeInfo, name, value);
+}
+std::shared_ptr<pragma::datasystem::Base> pragma::datasystem::Block::AddValue(const ValueTypeInfo &type, const std::string &name, const std::string &value)
+{
+	auto data = std::static_pointer_cast<Base>(std::shared_ptr<Value>(type.CreateValue(*m_dataSettings, value)));
 	AddData(name, data);
 	return data;
 }
@@ -482,12 +610,19 @@ bool pragma::datasystem::Block::GetRawVector4(const std::string_view &key, ::Vec
 ////////////////////////
 
 pragma::datasystem::Container::Container(Settings &dataSettings) : Base(dataSettings) {}
-pragma::datasystem::Container::~Container() { m_dataBlocks.clear(); }
+pragma::datasystem::Container::~Container()
+{
+	for(auto &block : m_dataBlocks)
+		block->RemoveParent(*this);
+	m_dataBlocks.clear();
+}
 bool pragma::datasystem::Container::IsContainer() const { return true; }
 void pragma::datasystem::Container::AddData(const std::shared_ptr<Block> &data)
 {
 	m_dataBlocks.push_back(data);
 	data->m_dataSettings = m_dataSettings;
+	data->AddParent(*this);
+	MarkChanged();
 }
 std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::Container::GetBlock(unsigned int id)
 {
@@ -495,7 +630,15 @@ std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::Container::GetBlo
 		return nullptr;
 	return m_dataBlocks[id];
 }
-std::vector<std::shared_ptr<pragma::datasystem::Block>> &pragma::datasystem::Container::GetBlocks() { return m_dataBlocks; }
+const std::vector<std::shared_ptr<pragma::datasystem::Block>> &pragma::datasystem::Container::GetBlocks() const { return m_dataBlocks; }
+void pragma::datasystem::Container::RemoveBlock(unsigned int id)
+{
+	if(id >= m_dataBlocks.size())
+		return;
+	m_dataBlocks[id]->RemoveParent(*this);
+	m_dataBlocks.erase(m_dataBlocks.begin() + id);
+	MarkChanged();
+}
 uint32_t pragma::datasystem::Container::GetBlockCount() const { return static_cast<unsigned int>(m_dataBlocks.size()); }
 
 ////////////////////////
@@ -605,8 +748,89 @@ static std::string ReadValue(unsigned long long c, ufile::IFile &f)
 	return val;
 }
 
-static bool read_block_data(pragma::datasystem::Block &block, const std::unordered_map<std::string, std::string> &enums, const std::shared_ptr<pragma::datasystem::Settings> &dataSettings, ufile::IFile &f, int &listID, std::string blockType = "", bool bMainBlock = false)
+namespace pragma::datasystem {
+	struct ParseContext {
+		ParseContext(const EnumTable &enums, const std::shared_ptr<Settings> &dataSettings) : enums(enums), dataSettings(dataSettings) {}
+		const EnumTable &enums;
+		std::shared_ptr<Settings> dataSettings;
+		bool inferTypes = false;
+		bool cacheConversions = false;
+		// Type tags are only looked up in the registry once per distinct tag
+		std::unordered_map<std::string, const ValueTypeInfo *, pragma::util::hl_string_hash, std::equal_to<>> valueTypes;
+		const ValueTypeInfo *FindValueType(const std::string &tag)
+		{
+			auto it = valueTypes.find(tag);
+			if(it != valueTypes.end())
+				return it->second;
+			auto *type = dataSettings->GetValueTypeRegistry().FindType(tag);
+			valueTypes.insert(std::make_pair(tag, type));
+			return type;
+		}
+	};
+};
+
+static void add_value(pragma::datasystem::Block &block, pragma::datasystem::ParseContext &ctx, const std::string &type, const std::string &name, const std::string &value)
+{
+	auto *typeInfo = ctx.FindValueType(type);
+	if(typeInfo == nullptr)
+		return;
+	auto data = block.AddValue(*typeInfo, name, value);
+	if(ctx.cacheConversions) {
+		if(auto *str = dynamic_cast<pragma::datasystem::String *>(data.get()))
+			str->SetConversionCacheEnabled(true);
+	}
+}
+
+// Returns true if the string is a decimal integer or floating point number which can be represented as int32_t or float.
+// Hexadecimal numbers, infinity and NaN are not considered numbers, so they are kept as strings.
+static bool is_number(std::string_view str, bool &outIsInteger)
+{
+	// from_chars does not accept a leading '+'
+	if(!str.empty() && str.front() == '+') {
+		str.remove_prefix(1);
+		if(!str.empty() && str.front() == '-')
+			return false;
+	}
+	// Rules out 'inf', 'infinity' and 'nan', which are accepted by from_chars
+	if(str.empty() || (!std::isdigit(static_cast<unsigned char>(str.back())) && str.back() != '.'))
+		return false;
+	auto *end = str.data() + str.size();
+	int32_t intValue;
+	auto result = std::from_chars(str.data(), end, intValue);
+	if(result.ptr == end) {
+		outIsInteger = true;
+		return result.ec == std::errc {};
+	}
+	float floatValue;
+	result = std::from_chars(str.data(), end, floatValue, std::chars_format::general);
+	outIsInteger = false;
+	return result.ec == std::errc {} && result.ptr == end;
+}
+// Determines the value type of an untyped value, which is used if type inference is enabled
+static const char *infer_value_type(const std::string &value)
 {
+	static const std::array<const char *, 4> vectorTypes {nullptr, "vector2", "vector", "vector4"};
+	std::istringstream ss {value};
+	std::string component;
+	uint32_t numComponents = 0;
+	auto isInteger = true;
+	while(ss >> component) {
+		bool isComponentInteger;
+		if(numComponents == vectorTypes.size() || !is_number(component, isComponentInteger))
+			return "string";
+		isInteger = isInteger && isComponentInteger;
+		++numComponents;
+	}
+	if(numComponents == 0)
+		return "string";
+	if(numComponents == 1)
+		return isInteger ? "int" : "float";
+	return vectorTypes[numComponents - 1];
+}
+
+static bool read_block_data(pragma::datasystem::Block &block, pragma::datasystem::ParseContext &ctx, ufile::IFile &f, int &listID, std::string blockType = "", bool bMainBlock = false)
+{
+	auto &enums = ctx.enums;
 	if(f.Eof())
 		return false;
 	auto c = FindFirstNotOf(f, pragma::string::WHITESPACE);
@@ -634,14 +858,13 @@ static bool read_block_data(pragma::datasystem::Block &block, const std::unorder
 			if(c == -1)
 				return false;
 			ident = ident.substr(1);
-			pragma::string::to_lower(ident);
 			if(c != '{') {
 				auto value = ReadValue(c, f);
 				pragma::string::remove_quotes(value);
-				auto it = enums.find(value);
-				if(it != enums.end())
-					value = it->second;
-				block.AddValue(ident, name, value);
+				auto *enumEntry = enums.Find(value);
+				if(enumEntry)
+					value = enumEntry->value;
+				add_value(block, ctx, ident, name, value);
 				//f.Seek(f.Tell() +1);
 				break;
 			}
@@ -659,10 +882,10 @@ static bool read_block_data(pragma::datasystem::Block &block, const std::unorder
 			switch(c) {
 			case '{':
 				{
-					auto sub = std::make_shared<pragma::datasystem::Block>(*dataSettings);
+					auto sub = std::make_shared<pragma::datasystem::Block>(*ctx.dataSettings);
 					bool r;
 					do
-						r = read_block_data(*sub, enums, dataSettings, f, listID, blockType);
+						r = read_block_data(*sub, ctx, f, listID, blockType);
 					while(r == true);
 					auto subBase = std::static_pointer_cast<pragma::datasystem::Base>(sub);
 					block.AddData(ident, subBase);
@@ -678,12 +901,14 @@ static bool read_block_data(pragma::datasystem::Block &block, const std::unorder
 				}
 			default:
 				{
-					if(blockType.empty())
-						blockType = "string";
-					auto it = enums.find(ident);
-					if(it != enums.end())
-						ident = it->second;
-					block.AddValue(blockType, std::to_string(listID), ident);
+					auto *enumEntry = enums.Find(ident);
+					if(enumEntry)
+						ident = enumEntry->value;
+					// The type of an untyped value only applies to the value itself and is not passed on to the following entries
+					std::string valueType = blockType;
+					if(valueType.empty())
+						valueType = ctx.inferTypes ? infer_value_type(ident) : "string";
+					add_value(block, ctx, valueType, std::to_string(listID), ident);
 					f.Seek(f.Tell() - 1);
 					listID++;
 					break;
@@ -693,7 +918,7 @@ static bool read_block_data(pragma::datasystem::Block &block, const std::unorder
 		}
 	}
 	if(bMainBlock == true)
-		read_block_data(block, enums, dataSettings, f, listID, blockType, bMainBlock);
+		read_block_data(block, ctx, f, listID, blockType, bMainBlock);
 	return true;
 }
 
@@ -715,49 +940,239 @@ void PrintBlocks(std::string name,DataBase *data,std::string t="\t")
 		PrintBlocks(i->first,i->second,t);
 }*/
 
-std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::System::ReadData(ufile::IFile &f, const std::unordered_map<std::string, std::string> &enums)
-{
-	auto dataSettings = pragma::datasystem::create_data_settings(enums);
+pragma::datasystem::LoadOptions::LoadOptions(const std::unordered_map<std::string, std::string> &enums) : enums(enums) {}
+pragma::datasystem::LoadOptions::LoadOptions(const std::shared_ptr<const EnumTable> &enumTable) : enumTable(enumTable) {}
 
-	auto data = std::make_shared<Block>(*dataSettings);
+static std::shared_ptr<pragma::datasystem::Block> parse_data(ufile::IFile &f, const pragma::datasystem::LoadOptions &options, const pragma::datasystem::EnumTable &enumTable, const std::shared_ptr<pragma::datasystem::Settings> &dataSettings)
+{
+	auto data = std::make_shared<pragma::datasystem::Block>(*dataSettings);
 	auto listID = 0;
 	// f.IgnoreComments("//");
 	// f.IgnoreComments("/*","*/");
 
-	if(read_block_data(*data, enums, dataSettings, f, listID, "", true) == false)
+	pragma::datasystem::ParseContext ctx {enumTable, dataSettings};
+	ctx.inferTypes = options.inferTypes;
+	ctx.cacheConversions = options.cacheConversions;
+	if(read_block_data(*data, ctx, f, listID, "", true) == false)
 		return nullptr;
 	return data;
 }
-std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::System::LoadData(const char *path, const std::unordered_map<std::string, std::string> &enums)
+static std::shared_ptr<pragma::datasystem::Block> read_data_sequential(ufile::IFile &f, const pragma::datasystem::LoadOptions &options, const std::shared_ptr<const pragma::datasystem::EnumTable> &enumTable)
 {
-	auto f = pragma::fs::open_file(path, pragma::fs::FileMode::Read);
-	if(f == nullptr)
+	auto dataSettings = pragma::datasystem::create_data_settings(enumTable, options.typeRegistry, options.stringPool);
+	return parse_data(f, options, *enumTable, dataSettings);
+}
+
+// Returns the offsets directly behind every '}' which closes a top-level block, at which the file can be split without changing the result.
+// Braces within quotes are ignored.
+// The parser carries the type of a typed top-level block ('$type "name" {}') over to all following top-level entries, and untyped
+// top-level values share a list index, so no split points are returned past the first one of those.
+static std::vector<size_t> find_top_level_block_ends(const std::vector<uint8_t> &data)
+{
+	std::vector<size_t> offsets;
+	uint32_t depth = 0;
+	auto inQuotes = false;
+	// Set if a top-level key has been read, which has to be followed by a block
+	auto hasKey = false;
+	for(size_t i = 0; i < data.size(); ++i) {
+		auto c = data[i];
+		if(c == '\"') {
+			if(!inQuotes && depth == 0) {
+				if(hasKey)
+					return offsets;
+				hasKey = true;
+			}
+			inQuotes = !inQuotes;
+			continue;
+		}
+		if(inQuotes)
+			continue;
+		if(c == '{') {
+			++depth;
+			hasKey = false;
+		}
+		else if(c == '}') {
+			if(depth > 0 && --depth == 0)
+				offsets.push_back(i + 1);
+		}
+		else if(depth == 0 && !std::isspace(c)) {
+			if(c == '$' || c == ',' || hasKey)
+				return offsets;
+			// Unquoted key
+			while(i + 1 < data.size() && !std::isspace(data[i + 1]) && data[i + 1] != '{' && data[i + 1] != '}' && data[i + 1] != ',')
+				++i;
+			hasKey = true;
+		}
+	}
+	return offsets;
+}
+
+// Moves all data from 'source' into 'target'. Blocks of containers are added individually, so duplicate keys
+// across both blocks end up in the same container in the same order as if they had been parsed sequentially.
+static void merge_block_data(pragma::datasystem::Block &target, const pragma::datasystem::Block &source)
+{
+	for(auto &pair : *source.GetData()) {
+		if(pair.second->IsContainer()) {
+			for(auto &block : static_cast<const pragma::datasystem::Container &>(*pair.second).GetBlocks())
+				target.AddData(pair.first, block);
+			continue;
+		}
+		target.AddData(pair.first, pair.second);
+	}
+}
+
+static std::shared_ptr<pragma::datasystem::Block> read_data_parallel(ufile::IFile &f, const pragma::datasystem::LoadOptions &options, const std::shared_ptr<const pragma::datasystem::EnumTable> &enumTable)
+{
+	auto data = pragma::datasystem::detail::read_stream_contents(f);
+	auto numThreads = (options.threadCount > 0) ? options.threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+
+	// The parser resets its list index after every block, so splitting behind a top-level block does not change the result
+	std::vector<std::pair<size_t, size_t>> ranges;
+	auto targetSize = data.size() / numThreads;
+	size_t start = 0;
+	for(auto offset : find_top_level_block_ends(data)) {
+		if(ranges.size() + 1 >= numThreads)
+			break;
+		if(offset - start < targetSize)
+			continue;
+		ranges.push_back({start, offset});
+		start = offset;
+	}
+	ranges.push_back({start, data.size()});
+
+	if(ranges.size() == 1) {
+		ufile::MemoryFile memFile {data.data(), data.size()};
+		return read_data_sequential(memFile, options, enumTable);
+	}
+
+	// All parts share the same settings, since they end up in the same document
+	auto dataSettings = pragma::datasystem::create_data_settings(enumTable, options.typeRegistry, options.stringPool);
+	std::vector<std::shared_ptr<pragma::datasystem::Block>> blocks(ranges.size());
+	std::vector<std::exception_ptr> exceptions(ranges.size());
+	pragma::datasystem::detail::run_parallel(static_cast<uint32_t>(ranges.size()), [&](uint32_t i) {
+		try {
+			auto &range = ranges[i];
+			ufile::MemoryFile memFile {data.data() + range.first, range.second - range.first};
+			blocks[i] = parse_data(memFile, options, *enumTable, dataSettings);
+		}
+		catch(...) {
+			exceptions[i] = std::current_exception();
+		}
+	});
+	for(auto &exception : exceptions) {
+		if(exception)
+			std::rethrow_exception(exception);
+	}
+	auto &root = blocks.front();
+	if(root == nullptr)
 		return nullptr;
-	fs::File fp {f};
-	return ReadData(fp, enums);
+	for(auto it = blocks.begin() + 1; it != blocks.end(); ++it) {
+		if(*it)
+			merge_block_data(*root, **it);
+	}
+	return root;
+}
+
+std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::detail::read_data(ufile::IFile &f, const LoadOptions &options)
+{
+	// Compile the enums only once, even if the file is parsed in parallel
+	auto enumTable = options.enumTable ? options.enumTable : std::make_shared<const EnumTable>(options.enums);
+	if(options.parallel)
+		return read_data_parallel(f, options, enumTable);
+	return read_data_sequential(f, options, enumTable);
+}
+std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::System::ReadData(ufile::IFile &f, const LoadOptions &options)
+{
+	auto data = detail::read_data(f, options);
+	if(data)
+		register_document(data, "");
+	return data;
+}
+std::shared_ptr<pragma::datasystem::Block> pragma::datasystem::System::LoadData(const char *path, const LoadOptions &options)
+{
+	std::shared_ptr<Block> data = nullptr;
+	if(auto prefetched = detail::take_prefetched_data(path)) {
+		ufile::MemoryFile fp {prefetched->data(), prefetched->size()};
+		data = detail::read_data(fp, options);
+	}
+	else {
+		// The file is read directly, so data from a prefetch request which has not been completed yet would be outdated
+		detail::discard_prefetched_data(path);
+		auto f = pragma::fs::open_file(path, pragma::fs::FileMode::Read);
+		if(f == nullptr)
+			return nullptr;
+		fs::File fp {f};
+		data = detail::read_data(fp, options);
+	}
+	if(data)
+		register_document(data, path);
+	return data;
 }
 
 ////////////////////////
 
-pragma::datasystem::String::String(Settings &dataSettings, const std::string &value) : Value(dataSettings), m_value(value) {}
-pragma::datasystem::Value *pragma::datasystem::String::Copy() { return new String(*m_dataSettings, GetValue()); }
+pragma::datasystem::String::String(Settings &dataSettings, const std::string &value) : Value(dataSettings), m_value(value, dataSettings.GetStringPool()) {}
+pragma::datasystem::String::String(Settings &dataSettings, const InternedString &value) : Value(dataSettings), m_value(value) {}
+pragma::datasystem::Value *pragma::datasystem::String::Copy() { return new String(*m_dataSettings, m_value); }
 pragma::datasystem::ValueType pragma::datasystem::String::GetType() const { return ValueType::String; }
 
-const std::string &pragma::datasystem::String::GetValue() const { return m_value; }
-void pragma::datasystem::String::SetValue(const std::string &value) { m_value = value; }
+std::string_view pragma::datasystem::String::GetValue() const { return m_value.GetView(); }
+const pragma::datasystem::InternedString &pragma::datasystem::String::GetInternedValue() const { return m_value; }
+void pragma::datasystem::String::SetValue(const std::string_view &value)
+{
+	m_value = InternedString {value, GetDataSettings().GetStringPool()};
+	if(m_conversionCache)
+		*m_conversionCache = std::monostate {};
+	MarkChanged();
+}
+void pragma::datasystem::String::SetConversionCacheEnabled(bool enabled)
+{
+	if(enabled == IsConversionCacheEnabled())
+		return;
+	m_conversionCache = enabled ? std::make_unique<ConversionCache>() : nullptr;
+}
+bool pragma::datasystem::String::IsConversionCacheEnabled() const { return m_conversionCache != nullptr; }
 
-std::string pragma::datasystem::String::GetString() const { return m_value; }
-int pragma::datasystem::String::GetInt() const { return pragma::util::to_int(m_value); }
-float pragma::datasystem::String::GetFloat() const { return pragma::util::to_float(m_value); }
-bool pragma::datasystem::String::GetBool() const { return pragma::util::to_boolean(m_value); }
-Color pragma::datasystem::String::GetColor() const { return ::Color {m_value}; }
-Vector3 pragma::datasystem::String::GetVector() const { return uvec::create(m_value); }
+std::string pragma::datasystem::String::GetString() const { return std::string {m_value.GetView()}; }
+// The color and vector helpers only accept std::string. A per-thread buffer is reused for them, so converting a value doesn't
+// allocate a temporary string every time.
+static const std::string &get_conversion_buffer(const std::string_view &value)
+{
+	thread_local std::string buffer;
+	buffer.assign(value);
+	return buffer;
+}
+int pragma::datasystem::String::GetInt() const
+{
+	return GetConvertedValue<int>([this]() { return pragma::util::to_int(m_value.GetView()); });
+}
+float pragma::datasystem::String::GetFloat() const
+{
+	return GetConvertedValue<float>([this]() { return pragma::util::to_float(m_value.GetView()); });
+}
+bool pragma::datasystem::String::GetBool() const
+{
+	return GetConvertedValue<bool>([this]() { return pragma::util::to_boolean(m_value.GetView()); });
+}
+Color pragma::datasystem::String::GetColor() const
+{
+	return GetConvertedValue<::Color>([this]() { return ::Color {get_conversion_buffer(m_value.GetView())}; });
+}
+Vector3 pragma::datasystem::String::GetVector() const
+{
+	return GetConvertedValue<Vector3>([this]() { return uvec::create(get_conversion_buffer(m_value.GetView())); });
+}
 Vector2 pragma::datasystem::String::GetVector2() const
 {
-	auto v = uvec::create(m_value);
-	return ::Vector2 {v.x, v.y};
+	return GetConvertedValue<::Vector2>([this]() {
+		auto v = uvec::create(get_conversion_buffer(m_value.GetView()));
+		return ::Vector2 {v.x, v.y};
+	});
+}
+Vector4 pragma::datasystem::String::GetVector4() const
+{
+	return GetConvertedValue<::Vector4>([this]() { return uvec::create_v4(get_conversion_buffer(m_value.GetView())); });
 }
-Vector4 pragma::datasystem::String::GetVector4() const { return uvec::create_v4(m_value); }
 std::string pragma::datasystem::String::GetTypeString() const { return "string"; }
 
 ////////////////////////
@@ -771,7 +1186,11 @@ pragma::datasystem::Int::Int(Settings &dataSettings, int32_t value) : Value(data
 pragma::datasystem::Value *pragma::datasystem::Int::Copy() { return new Int(*m_dataSettings, m_value); }
 pragma::datasystem::ValueType pragma::datasystem::Int::GetType() const { return ValueType::Int; }
 int32_t pragma::datasystem::Int::GetValue() const { return m_value; }
-void pragma::datasystem::Int::SetValue(int32_t value) { m_value = value; }
+void pragma::datasystem::Int::SetValue(int32_t value)
+{
+	m_value = value;
+	MarkChanged();
+}
 
 std::string pragma::datasystem::Int::GetString() const { return std::to_string(m_value); }
 int pragma::datasystem::Int::GetInt() const { return m_value; }
@@ -782,6 +1201,7 @@ Vector3 pragma::datasystem::Int::GetVector() const { return Vector3 {m_value, m_
 Vector2 pragma::datasystem::Int::GetVector2() const { return ::Vector2 {m_value, m_value}; }
 Vector4 pragma::datasystem::Int::GetVector4() const { return ::Vector4 {m_value, m_value, m_value, m_value}; }
 std::string pragma::datasystem::Int::GetTypeString() const { return "int"; }
+size_t pragma::datasystem::Int::GetMemoryUsage() const { return sizeof(*this); }
 
 ////////////////////////
 
@@ -794,7 +1214,11 @@ pragma::datasystem::Float::Float(Settings &dataSettings, float value) : Value(da
 pragma::datasystem::Value *pragma::datasystem::Float::Copy() { return new Float(*m_dataSettings, m_value); }
 pragma::datasystem::ValueType pragma::datasystem::Float::GetType() const { return ValueType::Float; }
 float pragma::datasystem::Float::GetValue() const { return m_value; }
-void pragma::datasystem::Float::SetValue(float value) { m_value = value; }
+void pragma::datasystem::Float::SetValue(float value)
+{
+	m_value = value;
+	MarkChanged();
+}
 
 std::string pragma::datasystem::Float::GetString() const { return std::to_string(m_value); }
 int pragma::datasystem::Float::GetInt() const { return m_value; }
@@ -809,6 +1233,7 @@ Vector3 pragma::datasystem::Float::GetVector() const { return Vector3 {m_value,
 Vector2 pragma::datasystem::Float::GetVector2() const { return ::Vector2 {m_value, m_value}; }
 Vector4 pragma::datasystem::Float::GetVector4() const { return ::Vector4 {m_value, m_value, m_value, m_value}; }
 std::string pragma::datasystem::Float::GetTypeString() const { return "float"; }
+size_t pragma::datasystem::Float::GetMemoryUsage() const { return sizeof(*this); }
 
 ////////////////////////
 
@@ -817,7 +1242,11 @@ pragma::datasystem::Bool::Bool(Settings &dataSettings, bool value) : Value(dataS
 pragma::datasystem::Value *pragma::datasystem::Bool::Copy() { return new Bool(*m_dataSettings, m_value); }
 pragma::datasystem::ValueType pragma::datasystem::Bool::GetType() const { return ValueType::Bool; }
 bool pragma::datasystem::Bool::GetValue() const { return m_value; }
-void pragma::datasystem::Bool::SetValue(bool value) { m_value = value; }
+void pragma::datasystem::Bool::SetValue(bool value)
+{
+	m_value = value;
+	MarkChanged();
+}
 
 std::string pragma::datasystem::Bool::GetString() const { return std::to_string(m_value); }
 int pragma::datasystem::Bool::GetInt() const { return m_value; }
@@ -828,3 +1257,4 @@ Vector3 pragma::datasystem::Bool::GetVector() const { return Vector3 {m_value, m
 Vector2 pragma::datasystem::Bool::GetVector2() const { return ::Vector2 {m_value, m_value}; }
 Vector4 pragma::datasystem::Bool::GetVector4() const { return ::Vector4 {m_value, m_value, m_value, m_value}; }
 std::string pragma::datasystem::Bool::GetTypeString() const { return "bool"; }
+size_t pragma::datasystem::Bool::GetMemoryUsage() const { return sizeof(*this); }
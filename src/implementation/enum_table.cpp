@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :core;
+
+static uint64_t hash_enum_name(const std::string_view &name) { return pragma::datasystem::detail::hash_string(name); }
+
+static std::string_view trim(const std::string_view &str)
+{
+	auto start = str.find_first_not_of(" \t\r\n");
+	if(start == std::string_view::npos)
+		return {};
+	auto end = str.find_last_not_of(" \t\r\n");
+	return str.substr(start, end - start + 1);
+}
+
+// Parses a decimal or hexadecimal ("0x") integer literal. The entire string has to be consumed.
+static std::optional<int64_t> parse_integer(std::string_view str)
+{
+	auto negative = false;
+	if(!str.empty() && (str.front() == '-' || str.front() == '+')) {
+		negative = (str.front() == '-');
+		str.remove_prefix(1);
+	}
+	auto base = 10;
+	if(str.size() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+		base = 16;
+		str.remove_prefix(2);
+	}
+	if(str.empty())
+		return {};
+	uint64_t value = 0;
+	auto *end = str.data() + str.size();
+	auto result = std::from_chars(str.data(), end, value, base);
+	if(result.ec != std::errc {} || result.ptr != end)
+		return {};
+	return negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+}
+
+pragma::datasystem::EnumTable::EnumTable(const std::unordered_map<std::string, std::string> &enums)
+{
+	m_entries.reserve(enums.size());
+	m_hashes.reserve(enums.size());
+	Rehash(std::bit_ceil(std::max<size_t>(enums.size() * 2, 16)));
+	for(auto &pair : enums)
+		Add(pair.first, pair.second);
+}
+void pragma::datasystem::EnumTable::Rehash(size_t slotCount)
+{
+	m_slots.clear();
+	m_slots.resize(slotCount, 0);
+	for(uint32_t i = 0; i < m_entries.size(); ++i)
+		m_slots[FindSlot(m_entries[i].name, m_hashes[i])] = i + 1;
+}
+uint32_t pragma::datasystem::EnumTable::FindSlot(const std::string_view &name, uint64_t hash) const
+{
+	// Linear probing; the table is kept at most half full, so there is always an empty slot
+	auto mask = m_slots.size() - 1;
+	auto slot = hash & mask;
+	for(;;) {
+		auto idx = m_slots[slot];
+		if(idx == 0 || (m_hashes[idx - 1] == hash && m_entries[idx - 1].name == name))
+			return static_cast<uint32_t>(slot);
+		slot = (slot + 1) & mask;
+	}
+}
+void pragma::datasystem::EnumTable::Add(const std::string &name, const std::string &value)
+{
+	if((m_entries.size() + 1) * 2 > m_slots.size())
+		Rehash(std::max<size_t>(m_slots.size() * 2, 16));
+	auto hash = hash_enum_name(name);
+	auto slot = FindSlot(name, hash);
+
+	Entry entry {name, value};
+	if(auto intValue = parse_integer(trim(value))) {
+		entry.intValue = *intValue;
+		entry.isInteger = true;
+	}
+	if(m_slots[slot] != 0) {
+		m_entries[m_slots[slot] - 1] = std::move(entry);
+		return;
+	}
+	m_entries.push_back(std::move(entry));
+	m_hashes.push_back(hash);
+	m_slots[slot] = static_cast<uint32_t>(m_entries.size());
+}
+const pragma::datasystem::EnumTable::Entry *pragma::datasystem::EnumTable::Find(const std::string_view &name) const
+{
+	if(m_entries.empty())
+		return nullptr;
+	auto idx = m_slots[FindSlot(name, hash_enum_name(name))];
+	return (idx != 0) ? &m_entries[idx - 1] : nullptr;
+}
+std::optional<int64_t> pragma::datasystem::EnumTable::FindValue(const std::string_view &name) const
+{
+	auto *entry = Find(name);
+	if(entry == nullptr || !entry->isInteger)
+		return {};
+	return entry->intValue;
+}
+std::optional<int64_t> pragma::datasystem::EnumTable::Evaluate(const std::string_view &expression) const
+{
+	int64_t result = 0;
+	size_t offset = 0;
+	for(;;) {
+		auto sep = expression.find('|', offset);
+		auto token = trim(expression.substr(offset, (sep != std::string_view::npos) ? (sep - offset) : std::string_view::npos));
+		if(token.empty())
+			return {};
+		auto value = parse_integer(token);
+		if(!value)
+			value = FindValue(token);
+		if(!value)
+			return {};
+		result |= *value;
+		if(sep == std::string_view::npos)
+			break;
+		offset = sep + 1;
+	}
+	return result;
+}
+const std::vector<pragma::datasystem::EnumTable::Entry> &pragma::datasystem::EnumTable::GetEntries() const { return m_entries; }
+bool pragma::datasystem::EnumTable::IsEmpty() const { return m_entries.empty(); }
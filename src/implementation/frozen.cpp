@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :frozen;
+
+std::shared_ptr<const pragma::datasystem::FrozenBlock> pragma::datasystem::Block::Freeze() const { return std::make_shared<const FrozenBlock>(*this); }
+
+pragma::datasystem::FrozenBlock::FrozenBlock(const Block &block)
+{
+	auto &data = *block.GetData();
+	m_entries.reserve(data.size());
+	for(auto &pair : data) {
+		Entry entry {};
+		entry.key = pair.first;
+		auto &base = *pair.second;
+		if(base.IsBlock())
+			entry.blocks.emplace_back(static_cast<const Block &>(base));
+		else if(base.IsContainer()) {
+			auto &blocks = static_cast<const Container &>(base).GetBlocks();
+			entry.blocks.reserve(blocks.size());
+			for(auto &child : blocks)
+				entry.blocks.emplace_back(*child);
+			entry.container = true;
+		}
+		else {
+			// User value types which don't override Copy would produce a plain Base object
+			std::unique_ptr<Base> copy {base.Copy()};
+			if(dynamic_cast<Value *>(copy.get()) == nullptr)
+				throw std::invalid_argument {"Value '" + pair.first + "' can't be frozen, since its type does not implement Copy!"};
+			entry.value = std::unique_ptr<Value> {static_cast<Value *>(copy.release())};
+		}
+		m_entries.push_back(std::move(entry));
+	}
+	std::sort(m_entries.begin(), m_entries.end(), [](const Entry &a, const Entry &b) { return a.key < b.key; });
+}
+pragma::datasystem::FrozenBlock::~FrozenBlock() {}
+const std::vector<pragma::datasystem::FrozenBlock::Entry> &pragma::datasystem::FrozenBlock::GetEntries() const { return m_entries; }
+const pragma::datasystem::FrozenBlock::Entry *pragma::datasystem::FrozenBlock::Find(const std::string_view &key) const
+{
+	auto it = std::lower_bound(m_entries.begin(), m_entries.end(), key, [](const Entry &entry, const std::string_view &key) { return std::string_view {entry.key} < key; });
+	if(it == m_entries.end() || it->key != key)
+		return nullptr;
+	return &*it;
+}
+const pragma::datasystem::FrozenBlock *pragma::datasystem::FrozenBlock::GetBlock(const std::string_view &key, uint32_t id) const
+{
+	auto *entry = Find(key);
+	if(entry == nullptr || id >= entry->blocks.size())
+		return nullptr;
+	return &entry->blocks[id];
+}
+uint32_t pragma::datasystem::FrozenBlock::GetBlockCount(const std::string_view &key) const
+{
+	auto *entry = Find(key);
+	return entry ? static_cast<uint32_t>(entry->blocks.size()) : 0;
+}
+const pragma::datasystem::Value *pragma::datasystem::FrozenBlock::GetValue(const std::string_view &key) const
+{
+	auto *entry = Find(key);
+	return entry ? entry->value.get() : nullptr;
+}
+bool pragma::datasystem::FrozenBlock::HasValue(const std::string_view &key) const { return Find(key) != nullptr; }
+bool pragma::datasystem::FrozenBlock::IsEmpty() const { return m_entries.empty(); }
+
+std::string pragma::datasystem::FrozenBlock::GetString(const std::string_view &key, const std::string &def) const
+{
+	auto *val = GetValue(key);
+	return val ? val->GetString() : def;
+}
+int pragma::datasystem::FrozenBlock::GetInt(const std::string_view &key, int def) const
+{
+	auto *val = GetValue(key);
+	return val ? val->GetInt() : def;
+}
+float pragma::datasystem::FrozenBlock::GetFloat(const std::string_view &key, float def) const
+{
+	auto *val = GetValue(key);
+	return val ? val->GetFloat() : def;
+}
+bool pragma::datasystem::FrozenBlock::GetBool(const std::string_view &key, bool def) const
+{
+	auto *val = GetValue(key);
+	return val ? val->GetBool() : def;
+}
+Color pragma::datasystem::FrozenBlock::GetColor(const std::string_view &key, const ::Color &def) const
+{
+	auto *val = GetValue(key);
+	return val ? val->GetColor() : def;
+}
+Vector2 pragma::datasystem::FrozenBlock::GetVector2(const std::string_view &key, const ::Vector2 &def) const
+{
+	auto *val = GetValue(key);
+	return val ? val->GetVector2() : def;
+}
+Vector3 pragma::datasystem::FrozenBlock::GetVector3(const std::string_view &key, const Vector3 &def) const
+{
+	auto *val = GetValue(key);
+	return val ? val->GetVector() : def;
+}
+Vector4 pragma::datasystem::FrozenBlock::GetVector4(const std::string_view &key, const ::Vector4 &def) const
+{
+	auto *val = GetValue(key);
+	return val ? val->GetVector4() : def;
+}
+
+////////////////////////
+
+pragma::datasystem::DocumentHandle::DocumentHandle(std::shared_ptr<const FrozenBlock> snapshot) : m_snapshot(std::move(snapshot)) {}
+std::shared_ptr<const pragma::datasystem::FrozenBlock> pragma::datasystem::DocumentHandle::Acquire() const { return m_snapshot.load(std::memory_order_acquire); }
+void pragma::datasystem::DocumentHandle::Publish(std::shared_ptr<const FrozenBlock> snapshot)
+{
+	m_snapshot.store(std::move(snapshot), std::memory_order_release);
+	m_version.fetch_add(1, std::memory_order_release);
+}
+void pragma::datasystem::DocumentHandle::Publish(const Block &block) { Publish(block.Freeze()); }
+uint64_t pragma::datasystem::DocumentHandle::GetVersion() const { return m_version.load(std::memory_order_acquire); }
+
+////////////////////////
+
+pragma::datasystem::DocumentReader::DocumentReader(const DocumentHandle &handle) : m_handle(handle) {}
+const pragma::datasystem::FrozenBlock *pragma::datasystem::DocumentReader::Get()
+{
+	// The version is incremented after the snapshot has been swapped, so a reader may at worst acquire the same snapshot twice, but never miss one
+	auto version = m_handle.GetVersion();
+	if(version != m_version) {
+		m_snapshot = m_handle.Acquire();
+		m_version = version;
+	}
+	return m_snapshot.get();
+}
+const pragma::datasystem::FrozenBlock *pragma::datasystem::DocumentReader::operator->() { return Get(); }
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :core;
+
+// Approximate size of a shared_ptr control block (vtable, use count, weak count)
+static constexpr size_t SHARED_PTR_CONTROL_BLOCK_SIZE = sizeof(void *) + sizeof(long) * 2;
+
+// Returns the amount of heap memory allocated by the string, or 0 if the string is stored in the small string buffer
+static size_t get_string_heap_size(const std::string &str)
+{
+	auto *data = reinterpret_cast<const uint8_t *>(str.data());
+	auto *obj = reinterpret_cast<const uint8_t *>(&str);
+	if(data >= obj && data < obj + sizeof(str))
+		return 0;
+	return str.capacity() + 1;
+}
+
+size_t pragma::datasystem::MemoryUsage::GetTotal() const { return nodeObjects + keyStrings + hashBuckets + stringValues + containers + userValues + serializedData; }
+pragma::datasystem::MemoryUsage &pragma::datasystem::MemoryUsage::operator+=(const MemoryUsage &other)
+{
+	nodeObjects += other.nodeObjects;
+	keyStrings += other.keyStrings;
+	hashBuckets += other.hashBuckets;
+	stringValues += other.stringValues;
+	containers += other.containers;
+	userValues += other.userValues;
+	serializedData += other.serializedData;
+	return *this;
+}
+
+bool pragma::datasystem::MemoryUsageContext::Visit(const void *ptr) { return m_visited.insert(ptr).second; }
+
+////////////////////////
+
+void pragma::datasystem::Base::CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const
+{
+	if(!context.Visit(this))
+		return;
+	usage.nodeObjects += sizeof(*this) + SHARED_PTR_CONTROL_BLOCK_SIZE;
+}
+
+pragma::datasystem::MemoryUsage pragma::datasystem::Block::ComputeMemoryUsage() const
+{
+	MemoryUsage usage {};
+	MemoryUsageContext context {};
+	CollectMemoryUsage(usage, context);
+	return usage;
+}
+void pragma::datasystem::Block::CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const
+{
+	if(!context.Visit(this))
+		return;
+	usage.nodeObjects += sizeof(*this) + SHARED_PTR_CONTROL_BLOCK_SIZE;
+
+	// Hash map nodes consist of a next-pointer, the key/value pair and the cached hash code
+	usage.hashBuckets += m_data.bucket_count() * sizeof(void *);
+	usage.hashBuckets += m_data.size() * (sizeof(void *) + sizeof(size_t) + sizeof(std::shared_ptr<Base>));
+	for(auto &pair : m_data) {
+		usage.keyStrings += sizeof(pair.first) + get_string_heap_size(pair.first);
+		pair.second->CollectMemoryUsage(usage, context);
+	}
+	if(m_serializedFragment) {
+		usage.serializedData += sizeof(*m_serializedFragment) + m_serializedFragment->segments.capacity() * sizeof(SerializedFragment::Segment);
+		for(auto &segment : m_serializedFragment->segments)
+			usage.serializedData += get_string_heap_size(segment.text);
+	}
+}
+
+void pragma::datasystem::Container::CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const
+{
+	if(!context.Visit(this))
+		return;
+	usage.nodeObjects += sizeof(*this) + SHARED_PTR_CONTROL_BLOCK_SIZE;
+	usage.containers += m_dataBlocks.capacity() * sizeof(std::shared_ptr<Block>);
+	for(auto &block : m_dataBlocks)
+		block->CollectMemoryUsage(usage, context);
+}
+
+size_t pragma::datasystem::Value::GetMemoryUsage() const { return sizeof(*this); }
+void pragma::datasystem::Value::CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const
+{
+	if(!context.Visit(this))
+		return;
+	auto size = GetMemoryUsage() + SHARED_PTR_CONTROL_BLOCK_SIZE;
+	if(GetType() == ValueType::User)
+		usage.userValues += size;
+	else
+		usage.nodeObjects += size;
+}
+
+static size_t get_string_entry_size(const pragma::datasystem::StringPool::Entry &entry) { return entry.GetSize(); }
+size_t pragma::datasystem::String::GetMemoryUsage() const
+{
+	auto *entry = m_value.GetEntry();
+	return sizeof(*this) + (entry ? get_string_entry_size(*entry) : 0) + (m_conversionCache ? sizeof(*m_conversionCache) : 0);
+}
+void pragma::datasystem::String::CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const
+{
+	if(!context.Visit(this))
+		return;
+	usage.nodeObjects += sizeof(*this) + SHARED_PTR_CONTROL_BLOCK_SIZE;
+	if(m_conversionCache)
+		usage.nodeObjects += sizeof(*m_conversionCache);
+	// Pooled strings are shared between values and only counted once
+	auto *entry = m_value.GetEntry();
+	if(entry && context.Visit(entry))
+		usage.stringValues += get_string_entry_size(*entry);
+}
+
+////////////////////////
+
+namespace pragma::datasystem {
+	struct DocumentEntry {
+		std::string name;
+		std::weak_ptr<Block> document;
+	};
+};
+static std::mutex g_documentMutex;
+static std::vector<pragma::datasystem::DocumentEntry> g_documents;
+
+void pragma::datasystem::register_document(const std::shared_ptr<Block> &document, const std::string &name)
+{
+	std::scoped_lock lock {g_documentMutex};
+	std::erase_if(g_documents, [](const DocumentEntry &entry) { return entry.document.expired(); });
+	g_documents.push_back({name, document});
+}
+std::vector<pragma::datasystem::DocumentInfo> pragma::datasystem::get_live_documents()
+{
+	std::scoped_lock lock {g_documentMutex};
+	std::erase_if(g_documents, [](const DocumentEntry &entry) { return entry.document.expired(); });
+	std::vector<DocumentInfo> documents;
+	documents.reserve(g_documents.size());
+	for(auto &entry : g_documents) {
+		auto document = entry.document.lock();
+		if(document)
+			documents.push_back({entry.name, std::move(document)});
+	}
+	return documents;
+}
+void pragma::datasystem::dump_document_memory_usage(std::ostream &os)
+{
+	auto documents = get_live_documents();
+	std::vector<std::pair<const DocumentInfo *, MemoryUsage>> usages;
+	usages.reserve(documents.size());
+	MemoryUsage total {};
+	for(auto &info : documents) {
+		auto usage = info.document->ComputeMemoryUsage();
+		total += usage;
+		usages.push_back({&info, usage});
+	}
+	std::sort(usages.begin(), usages.end(), [](const auto &a, const auto &b) { return a.second.GetTotal() > b.second.GetTotal(); });
+
+	auto printUsage = [&os](const std::string &name, const MemoryUsage &usage) {
+		os << name << ": " << usage.GetTotal() << " bytes (nodes: " << usage.nodeObjects << ", keys: " << usage.keyStrings << ", buckets: " << usage.hashBuckets << ", strings: " << usage.stringValues << ", containers: " << usage.containers
+		   << ", user values: " << usage.userValues << ", serialized: " << usage.serializedData << ")\n";
+	};
+	for(auto &[info, usage] : usages)
+		printUsage(info->name.empty() ? "<unnamed>" : info->name, usage);
+	printUsage("Total (" + std::to_string(documents.size()) + " documents)", total);
+}
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :core;
+
+pragma::datasystem::StringPool::Entry::Entry(size_t hash, size_t length) : hash(hash), length(length) {}
+pragma::datasystem::StringPool::Entry *pragma::datasystem::StringPool::Entry::Create(const std::string_view &value, size_t hash)
+{
+	auto *data = static_cast<char *>(::operator new(sizeof(Entry) + value.size()));
+	auto *entry = new(data) Entry {hash, value.size()};
+	std::memcpy(data + sizeof(Entry), value.data(), value.size());
+	return entry;
+}
+void pragma::datasystem::StringPool::Entry::Destroy(Entry *entry)
+{
+	entry->~Entry();
+	::operator delete(entry);
+}
+std::string_view pragma::datasystem::StringPool::Entry::GetValue() const { return std::string_view {reinterpret_cast<const char *>(this) + sizeof(Entry), length}; }
+size_t pragma::datasystem::StringPool::Entry::GetSize() const { return sizeof(Entry) + length; }
+
+pragma::datasystem::StringPool::~StringPool()
+{
+	// Entries which are still referenced by values stay alive until the last value releases them
+	for(auto &pair : m_entries) {
+		if(pair.second->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			Entry::Destroy(pair.second);
+	}
+}
+pragma::datasystem::StringPool::Entry *pragma::datasystem::StringPool::Acquire(const std::string_view &str)
+{
+	std::scoped_lock lock {m_mutex};
+	auto it = m_entries.find(str);
+	if(it != m_entries.end()) {
+		it->second->refCount.fetch_add(1, std::memory_order_relaxed);
+		return it->second;
+	}
+	// The pool holds one reference, the caller the other
+	auto *entry = Entry::Create(str, std::hash<std::string_view> {}(str));
+	entry->refCount.store(2, std::memory_order_relaxed);
+	m_entries.insert(std::make_pair(entry->GetValue(), entry));
+	return entry;
+}
+void pragma::datasystem::StringPool::Purge()
+{
+	std::scoped_lock lock {m_mutex};
+	// New references can only be created through Acquire, so an entry which is only referenced by the pool cannot be revived concurrently
+	std::erase_if(m_entries, [](const auto &pair) {
+		if(pair.second->refCount.load(std::memory_order_acquire) != 1)
+			return false;
+		Entry::Destroy(pair.second);
+		return true;
+	});
+}
+size_t pragma::datasystem::StringPool::GetCount() const
+{
+	std::scoped_lock lock {m_mutex};
+	return m_entries.size();
+}
+
+const std::shared_ptr<pragma::datasystem::StringPool> &pragma::datasystem::get_global_string_pool()
+{
+	static auto pool = std::make_shared<StringPool>();
+	return pool;
+}
+
+////////////////////////
+
+pragma::datasystem::InternedString::InternedString() { m_data[MAX_INLINE_LENGTH] = 0; }
+pragma::datasystem::InternedString::InternedString(const std::string_view &str, StringPool *pool)
+{
+	if(str.size() <= MAX_INLINE_LENGTH) {
+		std::memcpy(m_data, str.data(), str.size());
+		m_data[MAX_INLINE_LENGTH] = static_cast<char>(str.size());
+		return;
+	}
+	auto *entry = pool ? pool->Acquire(str) : StringPool::Entry::Create(str, std::hash<std::string_view> {}(str));
+	std::memcpy(m_data, &entry, sizeof(entry));
+	m_data[MAX_INLINE_LENGTH] = static_cast<char>(ENTRY_TAG);
+}
+pragma::datasystem::InternedString::InternedString(const InternedString &other)
+{
+	std::memcpy(m_data, other.m_data, sizeof(m_data));
+	if(auto *entry = GetEntry())
+		entry->refCount.fetch_add(1, std::memory_order_relaxed);
+}
+pragma::datasystem::InternedString::InternedString(InternedString &&other) noexcept
+{
+	std::memcpy(m_data, other.m_data, sizeof(m_data));
+	other.m_data[MAX_INLINE_LENGTH] = 0;
+}
+pragma::datasystem::InternedString::~InternedString() { Release(); }
+pragma::datasystem::InternedString &pragma::datasystem::InternedString::operator=(const InternedString &other)
+{
+	if(this == &other)
+		return *this;
+	if(auto *entry = other.GetEntry())
+		entry->refCount.fetch_add(1, std::memory_order_relaxed);
+	Release();
+	std::memcpy(m_data, other.m_data, sizeof(m_data));
+	return *this;
+}
+pragma::datasystem::InternedString &pragma::datasystem::InternedString::operator=(InternedString &&other) noexcept
+{
+	if(this == &other)
+		return *this;
+	Release();
+	std::memcpy(m_data, other.m_data, sizeof(m_data));
+	other.m_data[MAX_INLINE_LENGTH] = 0;
+	return *this;
+}
+void pragma::datasystem::InternedString::Release()
+{
+	auto *entry = GetEntry();
+	if(entry && entry->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		StringPool::Entry::Destroy(const_cast<StringPool::Entry *>(entry));
+	m_data[MAX_INLINE_LENGTH] = 0;
+}
+bool pragma::datasystem::InternedString::operator==(const InternedString &other) const
+{
+	// Strings of up to MAX_INLINE_LENGTH characters are always stored inline, so inline and pooled strings can never be equal
+	if(m_data[MAX_INLINE_LENGTH] != other.m_data[MAX_INLINE_LENGTH])
+		return false;
+	if(IsInline())
+		return std::memcmp(m_data, other.m_data, static_cast<uint8_t>(m_data[MAX_INLINE_LENGTH])) == 0;
+	auto *entry = GetEntry();
+	auto *otherEntry = other.GetEntry();
+	return entry == otherEntry || (entry->hash == otherEntry->hash && entry->GetValue() == otherEntry->GetValue());
+}
+std::string_view pragma::datasystem::InternedString::GetView() const
+{
+	if(IsInline())
+		return std::string_view {m_data, static_cast<uint8_t>(m_data[MAX_INLINE_LENGTH])};
+	return GetEntry()->GetValue();
+}
+size_t pragma::datasystem::InternedString::GetHash() const
+{
+	if(IsInline())
+		return std::hash<std::string_view> {}(GetView());
+	return GetEntry()->hash;
+}
+bool pragma::datasystem::InternedString::IsInline() const { return static_cast<uint8_t>(m_data[MAX_INLINE_LENGTH]) != ENTRY_TAG; }
+const pragma::datasystem::StringPool::Entry *pragma::datasystem::InternedString::GetEntry() const
+{
+	if(IsInline())
+		return nullptr;
+	StringPool::Entry *entry;
+	std::memcpy(&entry, m_data, sizeof(entry));
+	return entry;
+}
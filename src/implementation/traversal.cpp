@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :traversal;
+
+pragma::datasystem::DepthFirstRange::Iterator::Iterator(const Block &root)
+{
+	// Most documents are only a few levels deep, so this avoids re-allocations during the traversal
+	m_stack.reserve(16);
+	PushBlock(root);
+	SkipExhaustedFrames();
+}
+void pragma::datasystem::DepthFirstRange::Iterator::PushBlock(const Block &block)
+{
+	auto *data = block.GetData();
+	m_stack.push_back({data->begin(), data->end()});
+}
+void pragma::datasystem::DepthFirstRange::Iterator::SkipExhaustedFrames()
+{
+	while(!m_stack.empty()) {
+		auto &frame = m_stack.back();
+		auto exhausted = frame.container ? (frame.containerIndex >= frame.container->GetBlockCount()) : (frame.it == frame.end);
+		if(!exhausted)
+			break;
+		m_stack.pop_back();
+	}
+}
+pragma::datasystem::DepthFirstRange::Entry pragma::datasystem::DepthFirstRange::Iterator::operator*() const
+{
+	auto &frame = m_stack.back();
+	auto depth = static_cast<uint32_t>(m_stack.size() - 1);
+	if(frame.container)
+		return {*frame.containerKey, frame.container->GetBlockRange()[frame.containerIndex], depth};
+	return {frame.it->first, *frame.it->second, depth};
+}
+pragma::datasystem::DepthFirstRange::Iterator &pragma::datasystem::DepthFirstRange::Iterator::operator++()
+{
+	auto &frame = m_stack.back();
+	if(frame.container) {
+		auto &block = frame.container->GetBlockRange()[frame.containerIndex++];
+		PushBlock(block);
+	}
+	else {
+		auto &key = frame.it->first;
+		auto &data = *frame.it->second;
+		++frame.it;
+		// Note: 'frame' may be invalidated past this point
+		if(data.IsBlock())
+			PushBlock(static_cast<const Block &>(data));
+		else if(data.IsContainer())
+			m_stack.push_back({{}, {}, &static_cast<const Container &>(data), &key});
+	}
+	SkipExhaustedFrames();
+	return *this;
+}
+void pragma::datasystem::DepthFirstRange::Iterator::operator++(int) { ++*this; }
+bool pragma::datasystem::DepthFirstRange::Iterator::operator==(std::default_sentinel_t) const { return m_stack.empty(); }
+
+pragma::datasystem::DepthFirstRange::DepthFirstRange(const Block &root) : m_root(root) {}
+pragma::datasystem::DepthFirstRange::Iterator pragma::datasystem::DepthFirstRange::begin() const { return Iterator {m_root}; }
+std::default_sentinel_t pragma::datasystem::DepthFirstRange::end() const { return std::default_sentinel; }
+
+pragma::datasystem::DepthFirstRange pragma::datasystem::traverse_depth_first(const Block &block) { return DepthFirstRange {block}; }
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module pragma.datasystem;
+
+import :core;
+
+pragma::datasystem::Value *pragma::datasystem::ValueTypeInfo::CreateValue(Settings &dataSettings, const std::string &value) const
+{
+	if(factory)
+		return factory(dataSettings, value);
+	return factoryFunction(dataSettings, value);
+}
+
+////////////////////////
+
+pragma::datasystem::ValueTypeId pragma::datasystem::ValueTypeRegistry::Register(const std::string &name, ValueTypeInfo::Factory factory) { return Register(name, factory, nullptr); }
+pragma::datasystem::ValueTypeId pragma::datasystem::ValueTypeRegistry::Register(const std::string &name, const ValueTypeInfo::FactoryFunction &factory) { return Register(name, nullptr, factory); }
+pragma::datasystem::ValueTypeId pragma::datasystem::ValueTypeRegistry::Register(const std::string &name, ValueTypeInfo::Factory factory, const ValueTypeInfo::FactoryFunction &factoryFunction)
+{
+	auto lname = name;
+	pragma::string::to_lower(lname);
+	std::unique_lock lock {m_mutex};
+	auto it = m_nameToId.find(lname);
+	if(it != m_nameToId.end())
+		return it->second;
+	auto id = static_cast<ValueTypeId>(m_types.size());
+	m_types.push_back({lname, id, factory, factoryFunction});
+	m_nameToId.insert(std::make_pair(lname, id));
+	return id;
+}
+void pragma::datasystem::ValueTypeRegistry::RegisterBaseTypes()
+{
+	Register<Bool>("bool");
+	Register<Float>("float");
+	Register<Int>("int");
+	Register<String>("string");
+
+	Register<Vector>("vector");
+	Register<Vector2>("vector2");
+	Register<Vector4>("vector4");
+
+	Register<Color>("color");
+	Register<AssetReference>("texture");
+}
+const pragma::datasystem::ValueTypeInfo *pragma::datasystem::ValueTypeRegistry::FindType(const std::string_view &name) const
+{
+	std::shared_lock lock {m_mutex};
+	auto it = m_nameToId.find(name);
+	if(it == m_nameToId.end()) {
+		// Type tags are usually written in lower case, so we only pay for the conversion if the exact lookup fails
+		std::string lname {name};
+		pragma::string::to_lower(lname);
+		it = m_nameToId.find(lname);
+		if(it == m_nameToId.end())
+			return nullptr;
+	}
+	return &m_types[it->second];
+}
+const pragma::datasystem::ValueTypeInfo *pragma::datasystem::ValueTypeRegistry::GetType(ValueTypeId id) const
+{
+	std::shared_lock lock {m_mutex};
+	if(id >= m_types.size())
+		return nullptr;
+	return &m_types[id];
+}
+pragma::datasystem::ValueTypeId pragma::datasystem::ValueTypeRegistry::FindTypeId(const std::string_view &name) const
+{
+	auto *type = FindType(name);
+	return type ? type->id : INVALID_VALUE_TYPE_ID;
+}
+void pragma::datasystem::ValueTypeRegistry::Clear()
+{
+	std::unique_lock lock {m_mutex};
+	m_types.clear();
+	m_nameToId.clear();
+}
+
+const std::shared_ptr<pragma::datasystem::ValueTypeRegistry> &pragma::datasystem::get_default_value_type_registry()
+{
+	static auto registry = std::make_shared<ValueTypeRegistry>();
+	return registry;
+}
+
+////////////////////////
+
+void pragma::datasystem::ValueTypeMap::AddFactory(const std::string &name, const std::function<Value *(Settings &, const std::string &)> &factory) { get_default_value_type_registry()->Register(name, factory); }
+std::function<pragma::datasystem::Value *(pragma::datasystem::Settings &, const std::string &)> pragma::datasystem::ValueTypeMap::FindFactory(const std::string &name)
+{
+	auto *type = get_default_value_type_registry()->FindType(name);
+	if(type == nullptr)
+		return nullptr;
+	if(type->factoryFunction)
+		return type->factoryFunction;
+	return type->factory;
+}
+pragma::datasystem::ValueTypeMap *pragma::datasystem::get_data_value_type_map()
+{
+	static ValueTypeMap map {};
+	return &map;
+}
@@ -11,8 +11,15 @@ pragma::datasystem::Vector::Vector(Settings &dataSettings, const Vector3 &value)
 pragma::datasystem::Vector *pragma::datasystem::Vector::Copy() { return new Vector(*m_dataSettings, m_value); }
 pragma::datasystem::ValueType pragma::datasystem::Vector::GetType() const { return ValueType::Vector3; }
 const Vector3 &pragma::datasystem::Vector::GetValue() const { return m_value; }
-void pragma::datasystem::Vector::SetValue(const Vector3 &value) { m_value = value; }
+void pragma::datasystem::Vector::SetValue(const Vector3 &value)
+{
+	m_value = value;
+	MarkChanged();
+}
 std::string pragma::datasystem::Vector::GetTypeString() const { return "vector"; }
+size_t pragma::datasystem::Vector::GetMemoryUsage() const { return sizeof(*this); }
+uint64_t pragma::datasystem::Vector::ContentHash() const { return detail::hash_components(GetType(), m_value); }
+bool pragma::datasystem::Vector::Equals(const Value &other) const { return typeid(other) == typeid(*this) && detail::bitwise_equal(static_cast<const Vector &>(other).m_value, m_value); }
 std::string pragma::datasystem::Vector::GetString() const
 {
 	std::stringstream ss;
@@ -32,10 +39,17 @@ Vector4 pragma::datasystem::Vector::GetVector4() const { return ::Vector4 {m_val
 pragma::datasystem::Vector4::Vector4(Settings &dataSettings, const std::string &value) : Value(dataSettings) { pragma::string::string_to_array<::Vector4::value_type>(value, &m_value[0], pragma::string::cstring_to_number<float>, 4); }
 pragma::datasystem::Vector4::Vector4(Settings &dataSettings, const ::Vector4 &value) : Value(dataSettings), m_value(value) {}
 std::string pragma::datasystem::Vector4::GetTypeString() const { return "vector4"; }
+size_t pragma::datasystem::Vector4::GetMemoryUsage() const { return sizeof(*this); }
+uint64_t pragma::datasystem::Vector4::ContentHash() const { return detail::hash_components(GetType(), m_value); }
+bool pragma::datasystem::Vector4::Equals(const Value &other) const { return typeid(other) == typeid(*this) && detail::bitwise_equal(static_cast<const Vector4 &>(other).m_value, m_value); }
 pragma::datasystem::Vector4 *pragma::datasystem::Vector4::Copy() { return new Vector4(*m_dataSettings, m_value); }
 pragma::datasystem::ValueType pragma::datasystem::Vector4::GetType() const { return ValueType::Vector4; }
 const Vector4 &pragma::datasystem::Vector4::GetValue() const { return m_value; }
-void pragma::datasystem::Vector4::SetValue(const ::Vector4 &value) { m_value = value; }
+void pragma::datasystem::Vector4::SetValue(const ::Vector4 &value)
+{
+	m_value = value;
+	MarkChanged();
+}
 
 std::string pragma::datasystem::Vector4::GetString() const
 {
@@ -58,8 +72,15 @@ pragma::datasystem::Vector2::Vector2(Settings &dataSettings, const ::Vector2 &va
 pragma::datasystem::Vector2 *pragma::datasystem::Vector2::Copy() { return new Vector2(*m_dataSettings, m_value); }
 pragma::datasystem::ValueType pragma::datasystem::Vector2::GetType() const { return ValueType::Vector2; }
 std::string pragma::datasystem::Vector2::GetTypeString() const { return "vector2"; }
+size_t pragma::datasystem::Vector2::GetMemoryUsage() const { return sizeof(*this); }
+uint64_t pragma::datasystem::Vector2::ContentHash() const { return detail::hash_components(GetType(), m_value); }
+bool pragma::datasystem::Vector2::Equals(const Value &other) const { return typeid(other) == typeid(*this) && detail::bitwise_equal(static_cast<const Vector2 &>(other).m_value, m_value); }
 const Vector2 &pragma::datasystem::Vector2::GetValue() const { return m_value; }
-void pragma::datasystem::Vector2::SetValue(const ::Vector2 &value) { m_value = value; }
+void pragma::datasystem::Vector2::SetValue(const ::Vector2 &value)
+{
+	m_value = value;
+	MarkChanged();
+}
 
 std::string pragma::datasystem::Vector2::GetString() const
 {
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.datasystem:asset;
+
+export import :core;
+
+export {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	namespace pragma::datasystem {
+		// Loads the asset with the given path. Returns nullptr if the asset could not be loaded.
+		using AssetLoader = std::function<std::shared_ptr<void>(const std::string &path)>;
+
+		// Shared state of all references to the same asset path across all documents
+		struct DLLDATASYSTEM AssetEntry {
+			AssetEntry(const std::string &path);
+			const std::string path;
+			// Loads the asset through the asset loader if it hasn't been loaded yet. If the loader fails, nullptr is returned and the next call tries again.
+			std::shared_ptr<void> Resolve();
+			bool IsResolved() const;
+		  private:
+			std::mutex m_mutex;
+			std::atomic<bool> m_resolved = false;
+			std::shared_ptr<void> m_asset = nullptr;
+		};
+
+		// Reference to an asset (e.g. a texture), which is only loaded through the asset loader when it is accessed for the first time.
+		class DLLDATASYSTEM AssetReference : public Value {
+		  public:
+			AssetReference(Settings &dataSettings, const std::string &value);
+			AssetReference(Settings &dataSettings, const std::shared_ptr<AssetEntry> &entry);
+			virtual AssetReference *Copy() override;
+			// Returns the path as it was specified. The path of the entry is normalized, so it may use different separators.
+			const std::string &GetPath() const;
+			void SetPath(const std::string &path);
+			const std::shared_ptr<AssetEntry> &GetEntry() const;
+			bool IsResolved() const;
+			std::shared_ptr<void> Resolve() const;
+			template<typename T>
+			std::shared_ptr<T> Resolve() const
+			{
+				return std::static_pointer_cast<T>(Resolve());
+			}
+
+			virtual std::string GetString() const override;
+			virtual std::string GetTypeString() const override;
+			virtual ValueType GetType() const override;
+			virtual int GetInt() const override;
+			virtual float GetFloat() const override;
+			virtual bool GetBool() const override;
+			virtual ::Color GetColor() const override;
+			virtual Vector3 GetVector() const override;
+			virtual ::Vector2 GetVector2() const override;
+			virtual ::Vector4 GetVector4() const override;
+			virtual size_t GetMemoryUsage() const override;
+		  private:
+			std::shared_ptr<AssetEntry> m_entry;
+			// Written back when the data is serialized, so loading and saving a file doesn't change it
+			std::string m_path;
+		};
+
+		DLLDATASYSTEM void set_asset_loader(const AssetLoader &loader);
+		// Returns the shared entry for the given path. Paths are normalized to forward slashes, so paths which only differ in their
+		// separators share the same entry. Entries stay alive as long as any reference to them exists.
+		DLLDATASYSTEM std::shared_ptr<AssetEntry> get_asset_entry(const std::string &path);
+		// Returns all asset references in the tree which have not been resolved yet. Each asset is only listed once.
+		DLLDATASYSTEM std::vector<std::shared_ptr<AssetEntry>> find_unresolved_assets(const Block &block);
+		// Resolves all of the specified assets, e.g. the result of find_unresolved_assets
+		DLLDATASYSTEM void resolve_assets(const std::vector<std::shared_ptr<AssetEntry>> &assets);
+	};
+#pragma warning(pop)
+}
@@ -38,12 +38,60 @@ export {
 		class Settings;
 		class Block;
 		class Container;
+		class FrozenBlock;
+		struct ValueTypeInfo;
+		class ValueTypeRegistry;
+		class EnumTable;
+		class StringPool;
+		using ValueTypeId = uint32_t;
+
+		// Approximate number of bytes used by a data tree, split up by category
+		struct DLLDATASYSTEM MemoryUsage {
+			size_t nodeObjects = 0;    // Block, Container and built-in value objects, including their shared_ptr control blocks
+			size_t keyStrings = 0;     // Key strings stored in the block hash maps
+			size_t hashBuckets = 0;    // Bucket arrays and per-entry node overhead of the block hash maps
+			size_t stringValues = 0;   // Heap memory owned by String values
+			size_t containers = 0;     // Block lists of Container objects
+			size_t userValues = 0;     // Values of user-registered types
+			size_t serializedData = 0; // Serialized fragments cached by Block::ToStringIncremental
+			size_t GetTotal() const;
+			MemoryUsage &operator+=(const MemoryUsage &other);
+		};
+		struct DLLDATASYSTEM MemoryUsageContext {
+			// Returns false if the object has already been accounted for
+			bool Visit(const void *ptr);
+		  private:
+			std::unordered_set<const void *> m_visited;
+		};
+
 		class DLLDATASYSTEM Base : public std::enable_shared_from_this<Base> {
 		  protected:
 			friend Container;
 			friend Block;
 			Base(Settings &dataSettings);
+			// Copies do not belong to any parent
+			Base(const Base &other);
+			Base &operator=(const Base &other);
+			// Invalidates any cached data derived from the content of this object. Returns false if nothing was cached.
+			virtual bool InvalidateCache();
+			void InvalidateAncestors();
 			std::shared_ptr<Settings> m_dataSettings = nullptr;
+
+			// Objects can be added to multiple blocks or containers. The first parent is stored inline, since sharing objects is rare.
+			void AddParent(Base &parent);
+			void RemoveParent(Base &parent);
+			template<typename TFunc>
+			void ForEachParent(const TFunc &func) const
+			{
+				if(m_parent)
+					func(*m_parent);
+				if(m_sharedParents) {
+					for(auto *parent : *m_sharedParents)
+						func(*parent);
+				}
+			}
+			Base *m_parent = nullptr;
+			std::unique_ptr<std::vector<Base *>> m_sharedParents = nullptr;
 		  public:
 			virtual bool IsBlock() const;
 			virtual bool IsContainer() const;
@@ -55,27 +103,62 @@ export {
 
 			const Settings &GetDataSettings() const;
 			Settings &GetDataSettings();
+
+			// Adds the memory used by this object (and its children) to 'usage'. Objects which have already been visited are skipped.
+			virtual void CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const;
+
+			// Hash over the keys, types and values of this object and all of its children
+			virtual uint64_t ContentHash() const;
+			// Invalidates the cached data of this object and its ancestors. This is called automatically by all mutating methods.
+			void MarkChanged();
 		};
 
+		// Iterates over a single block, or over all blocks of a container
 		class DLLDATASYSTEM Iterator {
 		  private:
-			Base &m_target;
+			// The target type is resolved once on construction, so stepping does not require any virtual calls
+			Block *m_block = nullptr;
+			Container *m_container = nullptr;
 			unsigned int m_index;
-			std::unordered_map<std::string, Base *> it;
 		  public:
 			Iterator(Base &data);
-			bool IsValid();
+			bool IsValid() const;
 			void operator++(int);
 			Block *operator->();
 			Block *get();
 		};
 
+		struct BlockEntry {
+			const std::string &key;
+			Base &data;
+		};
+
 		class DLLDATASYSTEM Value;
 		class DLLDATASYSTEM Block : public Base {
 		  public:
 			using DataMap = std::unordered_map<std::string, std::shared_ptr<Base>, pragma::util::hl_string_hash, std::equal_to<>>;
 		  private:
 			DataMap m_data;
+			mutable uint64_t m_contentHash = 0;
+			mutable bool m_contentHashValid = false;
+			virtual bool InvalidateCache() override;
+
+			// Serialized lines of this block only, which are only valid for the tab depth they were written with. The contents of
+			// child blocks are not copied, each segment is followed by the fragment of its child block (if there is one).
+			struct SerializedFragment {
+				struct Segment {
+					std::string text;
+					const Block *child;
+				};
+				std::vector<Segment> segments;
+				uint8_t tabDepth;
+			};
+			friend Base;
+			mutable std::unique_ptr<SerializedFragment> m_serializedFragment = nullptr;
+			const SerializedFragment &GetSerializedFragment(uint8_t tabDepth) const;
+			void WriteData(std::ostream &os, uint8_t tabDepth) const;
+			void WriteCachedData(std::ostream &os, uint8_t tabDepth) const;
+			std::string Serialize(const std::optional<std::string> &rootIdentifier, uint8_t tabDepth, bool useCache) const;
 
 			template<typename T, class TDs>
 			    requires(
@@ -86,6 +169,11 @@ export {
 			virtual ~Block() override;
 			virtual bool IsBlock() const override;
 			const DataMap *GetData() const;
+			// Non-owning view over all entries of this block
+			auto GetEntryRange() const
+			{
+				return m_data | std::views::transform([](const DataMap::value_type &pair) -> BlockEntry { return {pair.first, *pair.second}; });
+			}
 			void DetachData(Base &val);
 			void RemoveValue(const std::string &key);
 			bool IsEmpty() const;
@@ -93,8 +181,28 @@ export {
 			Block *Copy() override;
 			;
 			std::string ToString(const std::optional<std::string> &rootIdentifier, uint8_t tabDepth = 0) const;
+			// Same output as ToString, but each block caches its own serialized lines, so only blocks which have changed since the last call
+			// have to be serialized again. Changes to shared children invalidate the lines of every block they were added to. The cached text is roughly the size of the output, the output itself is still assembled in full.
+			// Note: The cache is not thread-safe.
+			std::string ToStringIncremental(const std::optional<std::string> &rootIdentifier, uint8_t tabDepth = 0) const;
+			// Releases the serialized data cached by ToStringIncremental for this block and all of its children
+			void ClearSerializationCache();
+			// Computes the memory used by this block and all of its children. Shared nodes are only counted once.
+			MemoryUsage ComputeMemoryUsage() const;
+			// Creates an immutable snapshot of this block, which can safely be read from multiple threads
+			// Throws std::invalid_argument if the block contains a value of a user type which does not implement Copy.
+			std::shared_ptr<const FrozenBlock> Freeze() const;
+			// The hash is computed lazily and cached until this block or one of its children changes.
+			// Note: The cache is not thread-safe, use Freeze if the block has to be read from multiple threads.
+			virtual uint64_t ContentHash() const override;
+			// Compares the content of both blocks. Blocks with different content hashes are rejected without comparing their children.
+			bool Equals(const Block &other) const;
+			virtual void CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const override;
+			// The data may already be part of other blocks, in which case it is shared and changes are propagated to all of them
 			virtual void AddData(const std::string &name, const std::shared_ptr<Base> &data);
 			std::shared_ptr<Base> AddValue(const std::string &type, const std::string &name, const std::string &value);
+			std::shared_ptr<Base> AddValue(ValueTypeId type, const std::string &name, const std::string &value);
+			std::shared_ptr<Base> AddValue(const ValueTypeInfo &type, const std::string &name, const std::string &value);
 
 			template<typename T>
 			    requires(std::is_arithmetic_v<T>)
@@ -174,13 +282,25 @@ export {
 			virtual ~Container() override;
 		  protected:
 			std::vector<std::shared_ptr<Block>> m_dataBlocks;
+			mutable uint64_t m_contentHash = 0;
+			mutable bool m_contentHashValid = false;
+			virtual bool InvalidateCache() override;
 		  public:
 			Container(Settings &dataSettings);
 			virtual bool IsContainer() const override;
 			void AddData(const std::shared_ptr<Block> &data);
 			std::shared_ptr<Block> GetBlock(unsigned int id = 0);
-			std::vector<std::shared_ptr<Block>> &GetBlocks();
+			const std::vector<std::shared_ptr<Block>> &GetBlocks() const;
+			void RemoveBlock(unsigned int id);
+			// Non-owning view over all blocks of this container
+			auto GetBlockRange() const
+			{
+				return m_dataBlocks | std::views::transform([](const std::shared_ptr<Block> &block) -> Block & { return *block; });
+			}
 			uint32_t GetBlockCount() const;
+			virtual void CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const override;
+			// Unlike blocks, the order of the blocks in a container is part of its content
+			virtual uint64_t ContentHash() const override;
 		};
 
 		class DLLDATASYSTEM Value : public Base {
@@ -190,6 +310,7 @@ export {
 			virtual std::string GetString() const = 0;
 			virtual bool IsValue() const override { return true; }
 			virtual std::string GetTypeString() const = 0;
+			// User types should return ValueType::User. If a built-in type is returned instead, the value is only treated as that type if it derives from its class.
 			virtual ValueType GetType() const { return ValueType::User; }
 			virtual int GetInt() const = 0;
 			virtual float GetFloat() const = 0;
@@ -198,40 +319,231 @@ export {
 			virtual Vector3 GetVector() const = 0;
 			virtual ::Vector2 GetVector2() const = 0;
 			virtual ::Vector4 GetVector4() const = 0;
+
+			// Size of the value object in bytes, including any memory it owns. User types should override this.
+			virtual size_t GetMemoryUsage() const;
+			virtual void CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const override;
+			// Hashes the type string and the string representation of the value. The built-in types hash their native values instead,
+			// user types should override this if their string representation is lossy.
+			virtual uint64_t ContentHash() const override;
+			// Returns true if both values are of the same type and have the same content. Has to be consistent with ContentHash.
+			virtual bool Equals(const Value &other) const;
+		};
+
+		// Compiled enum constants. Names are stored in a flat open-addressing hash table, and values are stored as 64-bit integers
+		// so large flag values do not lose precision. Build the table once and reuse it for all loads which use the same enums.
+		class DLLDATASYSTEM EnumTable {
+		  public:
+			struct Entry {
+				std::string name;
+				std::string value;
+				int64_t intValue = 0;
+				bool isInteger = false;
+			};
+			EnumTable() = default;
+			EnumTable(const std::unordered_map<std::string, std::string> &enums);
+			// If an enum with the same name already exists, it will be overwritten
+			void Add(const std::string &name, const std::string &value);
+			const Entry *Find(const std::string_view &name) const;
+			std::optional<int64_t> FindValue(const std::string_view &name) const;
+			// Evaluates an integer literal, an enum name or a combination of both separated by '|' (e.g. "FLAG_A | FLAG_B | 4")
+			// without going through the expression parser. Returns an empty optional if the expression has any other form.
+			std::optional<int64_t> Evaluate(const std::string_view &expression) const;
+			const std::vector<Entry> &GetEntries() const;
+			bool IsEmpty() const;
+		  private:
+			void Rehash(size_t slotCount);
+			uint32_t FindSlot(const std::string_view &name, uint64_t hash) const;
+			std::vector<Entry> m_entries;
+			std::vector<uint64_t> m_hashes;
+			// Entry index + 1 per slot, 0 for empty slots. The slot count is always a power of two.
+			std::vector<uint32_t> m_slots;
+		};
+
+		struct DLLDATASYSTEM LoadOptions {
+			LoadOptions() = default;
+			LoadOptions(const std::unordered_map<std::string, std::string> &enums);
+			LoadOptions(const std::shared_ptr<const EnumTable> &enumTable);
+			std::unordered_map<std::string, std::string> enums;
+			// Precompiled enums, takes precedence over 'enums'
+			std::shared_ptr<const EnumTable> enumTable = nullptr;
+			// If enabled, the file is split at top-level block boundaries and the parts are parsed on multiple threads
+			bool parallel = false;
+			// Maximum number of threads used for parallel parsing, or 0 to use all hardware threads
+			uint32_t threadCount = 0;
+			// Value types available to the document, or nullptr to use the default registry
+			std::shared_ptr<ValueTypeRegistry> typeRegistry = nullptr;
+			// If set, string values are deduplicated through this pool (e.g. get_global_string_pool())
+			std::shared_ptr<StringPool> stringPool = nullptr;
+			// If enabled, the conversion cache of all loaded string values is enabled (see String::SetConversionCacheEnabled).
+			// Must not be used for documents which are read from multiple threads.
+			bool cacheConversions = false;
+			// If enabled, values without a type tag are stored as int, float or vector values if they consist of one to four decimal numbers
+			// which fit into the respective type, instead of always being stored as strings
+			bool inferTypes = false;
 		};
 
 		class DLLDATASYSTEM System {
 		  public:
-			static std::shared_ptr<Block> ReadData(ufile::IFile &f, const std::unordered_map<std::string, std::string> &enums = {});
-			static std::shared_ptr<Block> LoadData(const char *path, const std::unordered_map<std::string, std::string> &enums = {});
+			using LoadCallback = std::function<void(const std::shared_ptr<Block> &)>;
+			static std::shared_ptr<Block> ReadData(ufile::IFile &f, const LoadOptions &options = {});
+			static std::shared_ptr<Block> LoadData(const char *path, const LoadOptions &options = {});
+
+			// Loads the file in the background. Files are read on a dedicated I/O thread and parsed on worker threads,
+			// so reading queued files overlaps with parsing previously read ones. The callback (if specified) is invoked on a worker thread
+			// before the future becomes ready. The result is nullptr if the file could not be opened or parsed, or if close() has already been called.
+			static std::future<std::shared_ptr<Block>> LoadDataAsync(const std::string &path, const LoadOptions &options = {}, const LoadCallback &callback = nullptr);
+			// Hints that the file will be loaded soon. Its contents are read in the background and consumed by the next LoadData or LoadDataAsync call for the same path.
+			static void PrefetchData(const std::string &path);
 		};
 
-		class DLLDATASYSTEM ValueTypeMap {
-		  private:
-			std::unordered_map<std::string, std::function<Value *(Settings &, const std::string &)>> m_factories;
+		constexpr ValueTypeId INVALID_VALUE_TYPE_ID = std::numeric_limits<ValueTypeId>::max();
+		struct DLLDATASYSTEM ValueTypeInfo {
+			using Factory = Value *(*)(Settings &, const std::string &);
+			using FactoryFunction = std::function<Value *(Settings &, const std::string &)>;
+			std::string name;
+			ValueTypeId id = INVALID_VALUE_TYPE_ID;
+			Factory factory = nullptr;
+			// Only used if the type was registered with a stateful factory
+			FactoryFunction factoryFunction = nullptr;
+			Value *CreateValue(Settings &dataSettings, const std::string &value) const;
+		};
+
+		// Assigns numeric ids to value types. Type names are case-insensitive.
+		// Type infos are never moved after registration, so pointers returned by FindType can be cached (e.g. once per type tag while parsing a file).
+		class DLLDATASYSTEM ValueTypeRegistry {
 		  public:
-			void AddFactory(const std::string &name, const std::function<Value *(Settings &, const std::string &)> &factory);
-			std::function<Value *(Settings &, const std::string &)> FindFactory(const std::string &name);
+			ValueTypeRegistry() = default;
+			ValueTypeRegistry(const ValueTypeRegistry &) = delete;
+			ValueTypeRegistry &operator=(const ValueTypeRegistry &) = delete;
+
+			// If a type with the same name already exists, the existing type is kept and its id is returned
+			ValueTypeId Register(const std::string &name, ValueTypeInfo::Factory factory);
+			ValueTypeId Register(const std::string &name, const ValueTypeInfo::FactoryFunction &factory);
+			template<typename T>
+			ValueTypeId Register(const std::string &name)
+			{
+				return Register(name, static_cast<ValueTypeInfo::Factory>([](Settings &dataSettings, const std::string &value) -> Value * { return new T {dataSettings, value}; }));
+			}
+			void RegisterBaseTypes();
+			const ValueTypeInfo *FindType(const std::string_view &name) const;
+			const ValueTypeInfo *GetType(ValueTypeId id) const;
+			ValueTypeId FindTypeId(const std::string_view &name) const;
+			void Clear();
+		  private:
+			ValueTypeId Register(const std::string &name, ValueTypeInfo::Factory factory, const ValueTypeInfo::FactoryFunction &factoryFunction);
+			mutable std::shared_mutex m_mutex;
+			std::deque<ValueTypeInfo> m_types;
+			std::unordered_map<std::string, ValueTypeId, pragma::util::hl_string_hash, std::equal_to<>> m_nameToId;
 		};
 
-		DLLDATASYSTEM void register_data_value_type(const std::string &type, const std::function<Value *(Settings &, const std::string &)> &factory);
+		// Registry used by all documents which were not loaded with a custom registry
+		DLLDATASYSTEM const std::shared_ptr<ValueTypeRegistry> &get_default_value_type_registry();
+		DLLDATASYSTEM void register_data_value_type(const std::string &type, const ValueTypeInfo::FactoryFunction &factory);
 		template<typename T>
 		void register_data_value_type(const std::string &type)
 		{
-			register_data_value_type(type, [](Settings &dataSettings, const std::string &value) -> Value * { return new T {dataSettings, value}; });
+			get_default_value_type_registry()->Register<T>(type);
 		}
 
+		// Deprecated: Only kept for compatibility, forwards to the default value type registry. Use get_default_value_type_registry() instead.
+		class DLLDATASYSTEM ValueTypeMap {
+		  public:
+			[[deprecated("Use get_default_value_type_registry()->Register instead")]] void AddFactory(const std::string &name, const std::function<Value *(Settings &, const std::string &)> &factory);
+			// Returns nullptr if no type with the given name has been registered
+			[[deprecated("Use get_default_value_type_registry()->FindType instead")]] std::function<Value *(Settings &, const std::string &)> FindFactory(const std::string &name);
+		};
+		[[deprecated("Use get_default_value_type_registry() instead")]] DLLDATASYSTEM ValueTypeMap *get_data_value_type_map();
+
 		DLLDATASYSTEM void register_base_types();
-		DLLDATASYSTEM ValueTypeMap *get_data_value_type_map();
-		DLLDATASYSTEM std::shared_ptr<Settings> create_data_settings(const std::unordered_map<std::string, std::string> &enums);
+		DLLDATASYSTEM std::shared_ptr<Settings> create_data_settings(const std::unordered_map<std::string, std::string> &enums, const std::shared_ptr<ValueTypeRegistry> &typeRegistry = nullptr);
+		DLLDATASYSTEM std::shared_ptr<Settings> create_data_settings(const std::shared_ptr<const EnumTable> &enumTable, const std::shared_ptr<ValueTypeRegistry> &typeRegistry = nullptr, const std::shared_ptr<StringPool> &stringPool = nullptr);
+		// Completes all pending asynchronous loads and stops the loader threads. Asynchronous loads which are started afterwards fail.
 		DLLDATASYSTEM void close();
 
+		struct DLLDATASYSTEM DocumentInfo {
+			std::string name;
+			std::shared_ptr<Block> document;
+		};
+		// Documents loaded through System::ReadData / System::LoadData are registered automatically
+		DLLDATASYSTEM void register_document(const std::shared_ptr<Block> &document, const std::string &name);
+		DLLDATASYSTEM std::vector<DocumentInfo> get_live_documents();
+		// Writes the memory usage of all live documents to 'os', largest first
+		DLLDATASYSTEM void dump_document_memory_usage(std::ostream &os);
+
+		// Deduplicates long string values. A pool can be shared by all values of a document, by multiple documents, or process-wide (see get_global_string_pool).
+		class DLLDATASYSTEM StringPool {
+		  public:
+			// The characters are stored directly behind the entry, so each entry only requires a single allocation
+			struct DLLDATASYSTEM Entry {
+				static Entry *Create(const std::string_view &value, size_t hash);
+				static void Destroy(Entry *entry);
+				Entry(const Entry &) = delete;
+				Entry &operator=(const Entry &) = delete;
+				std::string_view GetValue() const;
+				// Size of the allocation, including the characters
+				size_t GetSize() const;
+				const size_t hash;
+				const size_t length;
+				mutable std::atomic<uint32_t> refCount = 1;
+			  private:
+				Entry(size_t hash, size_t length);
+				~Entry() = default;
+			};
+			StringPool() = default;
+			StringPool(const StringPool &) = delete;
+			StringPool &operator=(const StringPool &) = delete;
+			~StringPool();
+			// Returns the entry for the string with an added reference
+			Entry *Acquire(const std::string_view &str);
+			// Removes all strings which are not referenced by any value anymore
+			void Purge();
+			size_t GetCount() const;
+		  private:
+			mutable std::mutex m_mutex;
+			std::unordered_map<std::string_view, Entry *> m_entries;
+		};
+		DLLDATASYSTEM const std::shared_ptr<StringPool> &get_global_string_pool();
+
+		// Compact string handle. Strings of up to MAX_INLINE_LENGTH characters are stored inline, longer strings are stored in a
+		// reference-counted entry, which is shared with all other handles of the same string if it was created through a StringPool.
+		// Comparing two pooled strings from the same pool is a pointer comparison.
+		class DLLDATASYSTEM InternedString {
+		  public:
+			static constexpr size_t MAX_INLINE_LENGTH = 23;
+			InternedString();
+			InternedString(const std::string_view &str, StringPool *pool = nullptr);
+			InternedString(const InternedString &other);
+			InternedString(InternedString &&other) noexcept;
+			~InternedString();
+			InternedString &operator=(const InternedString &other);
+			InternedString &operator=(InternedString &&other) noexcept;
+			bool operator==(const InternedString &other) const;
+
+			std::string_view GetView() const;
+			size_t GetHash() const;
+			bool IsInline() const;
+			// Returns nullptr if the string is stored inline
+			const StringPool::Entry *GetEntry() const;
+		  private:
+			static constexpr uint8_t ENTRY_TAG = std::numeric_limits<uint8_t>::max();
+			void Release();
+			// Either the inline characters or the entry pointer. The last byte holds the inline length or ENTRY_TAG.
+			alignas(void *) char m_data[MAX_INLINE_LENGTH + 1];
+		};
+
 		class DLLDATASYSTEM String : public Value {
 		  public:
 			String(Settings &dataSettings, const std::string &value);
+			String(Settings &dataSettings, const InternedString &value);
 			virtual Value *Copy() override;
-			const std::string &GetValue() const;
-			void SetValue(const std::string &value);
+			std::string_view GetValue() const;
+			const InternedString &GetInternedValue() const;
+			void SetValue(const std::string_view &value);
+			// If enabled, the result of the most recent numeric or vector conversion is cached until the value changes. The cache is disabled
+			// by default and is not copied with the value, since it is not thread-safe and must not be used if the value is read from multiple threads.
+			void SetConversionCacheEnabled(bool enabled);
+			bool IsConversionCacheEnabled() const;
 
 			virtual std::string GetString() const override;
 			virtual std::string GetTypeString() const override;
@@ -243,8 +555,26 @@ export {
 			virtual Vector3 GetVector() const override;
 			virtual ::Vector2 GetVector2() const override;
 			virtual ::Vector4 GetVector4() const override;
+			virtual size_t GetMemoryUsage() const override;
+			virtual void CollectMemoryUsage(MemoryUsage &usage, MemoryUsageContext &context) const override;
+			virtual uint64_t ContentHash() const override;
+			virtual bool Equals(const Value &other) const override;
 		  private:
-			std::string m_value;
+			template<typename T, typename TConvert>
+			T GetConvertedValue(const TConvert &convert) const
+			{
+				if(!m_conversionCache)
+					return convert();
+				if(auto *value = std::get_if<T>(m_conversionCache.get()))
+					return *value;
+				T value = convert();
+				*m_conversionCache = value;
+				return value;
+			}
+			InternedString m_value;
+			// Only allocated if the conversion cache is enabled
+			using ConversionCache = std::variant<std::monostate, int, float, bool, ::Color, Vector3, ::Vector2, ::Vector4>;
+			mutable std::unique_ptr<ConversionCache> m_conversionCache = nullptr;
 		};
 
 		class DLLDATASYSTEM Int : public Value {
@@ -265,6 +595,9 @@ export {
 			virtual Vector3 GetVector() const override;
 			virtual ::Vector2 GetVector2() const override;
 			virtual ::Vector4 GetVector4() const override;
+			virtual size_t GetMemoryUsage() const override;
+			virtual uint64_t ContentHash() const override;
+			virtual bool Equals(const Value &other) const override;
 		  private:
 			int32_t m_value;
 		};
@@ -287,6 +620,9 @@ export {
 			virtual Vector3 GetVector() const override;
 			virtual ::Vector2 GetVector2() const override;
 			virtual ::Vector4 GetVector4() const override;
+			virtual size_t GetMemoryUsage() const override;
+			virtual uint64_t ContentHash() const override;
+			virtual bool Equals(const Value &other) const override;
 		  private:
 			float m_value;
 		};
@@ -309,6 +645,9 @@ export {
 			virtual Vector3 GetVector() const override;
 			virtual ::Vector2 GetVector2() const override;
 			virtual ::Vector4 GetVector4() const override;
+			virtual size_t GetMemoryUsage() const override;
+			virtual uint64_t ContentHash() const override;
+			virtual bool Equals(const Value &other) const override;
 		  private:
 			bool m_value;
 		};
@@ -373,3 +712,34 @@ export {
 		}
 	};
 }
+
+namespace pragma::datasystem::detail {
+	std::shared_ptr<Block> read_data(ufile::IFile &f, const LoadOptions &options);
+	std::vector<uint8_t> read_stream_contents(ufile::IFile &f);
+	std::optional<std::vector<uint8_t>> read_file_contents(const std::string &path);
+	std::optional<std::vector<uint8_t>> take_prefetched_data(const std::string &path);
+	// Drops prefetched data for the path, as well as any prefetch request for it which is still pending
+	void discard_prefetched_data(const std::string &path);
+	void shutdown_async_loader();
+	// Calls 'task' for every index in [0, count) on the parser threads of the async loader and the calling thread, and waits for all calls to complete.
+	// The task must not throw.
+	void run_parallel(uint32_t count, const std::function<void(uint32_t)> &task);
+
+	// Stable 64-bit FNV-1a hash, which does not depend on the platform or standard library
+	uint64_t hash_string(const std::string_view &str);
+	uint64_t hash_combine(uint64_t seed, uint64_t hash);
+	// Hashes the object representations of the components, so floating-point values are hashed exactly instead of through their (rounded) string representation
+	template<typename... T>
+	uint64_t hash_components(ValueType type, const T &...components)
+	{
+		auto hash = hash_combine(0, static_cast<uint64_t>(type));
+		((hash = hash_combine(hash, hash_string(std::string_view {reinterpret_cast<const char *>(&components), sizeof(components)}))), ...);
+		return hash;
+	}
+	// Bitwise comparison which is consistent with hash_components (e.g. 0.0 and -0.0 are considered different)
+	template<typename T>
+	bool bitwise_equal(const T &a, const T &b)
+	{
+		return std::memcmp(&a, &b, sizeof(T)) == 0;
+	}
+};
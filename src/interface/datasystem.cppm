@@ -4,6 +4,9 @@
 module;
 
 export module pragma.datasystem;
+export import :asset;
 export import :color;
 export import :core;
+export import :frozen;
+export import :traversal;
 export import :vector;
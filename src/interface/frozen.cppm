@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.datasystem:frozen;
+
+export import :core;
+
+export {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	namespace pragma::datasystem {
+		// Immutable copy of a data tree. Entries are stored in a flat array sorted by key and are never modified after construction,
+		// so a frozen block can be read from any number of threads without synchronization. Lookups return plain pointers and do not touch any reference counts.
+		class DLLDATASYSTEM FrozenBlock {
+		  public:
+			struct Entry {
+				std::string key;
+				std::unique_ptr<Value> value;    // Set if the entry is a value
+				std::vector<FrozenBlock> blocks; // One block for a Block entry, all contained blocks for a Container entry
+				bool container = false;
+				bool IsValue() const { return value != nullptr; }
+				bool IsContainer() const { return container; }
+			};
+
+			explicit FrozenBlock(const Block &block);
+			FrozenBlock(const FrozenBlock &) = delete;
+			FrozenBlock(FrozenBlock &&) = default;
+			~FrozenBlock();
+			FrozenBlock &operator=(const FrozenBlock &) = delete;
+			FrozenBlock &operator=(FrozenBlock &&) = default;
+
+			const std::vector<Entry> &GetEntries() const;
+			const Entry *Find(const std::string_view &key) const;
+			const FrozenBlock *GetBlock(const std::string_view &key, uint32_t id = 0) const;
+			uint32_t GetBlockCount(const std::string_view &key) const;
+			const Value *GetValue(const std::string_view &key) const;
+			bool HasValue(const std::string_view &key) const;
+			bool IsEmpty() const;
+
+			std::string GetString(const std::string_view &key, const std::string &def = "") const;
+			int GetInt(const std::string_view &key, int def = 0) const;
+			float GetFloat(const std::string_view &key, float def = 0.f) const;
+			bool GetBool(const std::string_view &key, bool def = false) const;
+			::Color GetColor(const std::string_view &key, const ::Color &def = colors::White) const;
+			::Vector2 GetVector2(const std::string_view &key, const ::Vector2 &def = {}) const;
+			Vector3 GetVector3(const std::string_view &key, const Vector3 &def = {}) const;
+			::Vector4 GetVector4(const std::string_view &key, const ::Vector4 &def = {}) const;
+		  private:
+			std::vector<Entry> m_entries;
+		};
+
+		// Holds the most recently published snapshot of a document. A writer publishes a new version by atomically swapping the pointer (read-copy-update),
+		// old snapshots stay alive until their last reader releases them.
+		// Note: std::atomic<std::shared_ptr> is not lock-free on common standard libraries, and Acquire increments the reference count shared by all readers.
+		// Threads which read the document frequently should use a DocumentReader instead.
+		class DLLDATASYSTEM DocumentHandle {
+		  public:
+			DocumentHandle() = default;
+			DocumentHandle(std::shared_ptr<const FrozenBlock> snapshot);
+			DocumentHandle(const DocumentHandle &) = delete;
+			DocumentHandle &operator=(const DocumentHandle &) = delete;
+
+			std::shared_ptr<const FrozenBlock> Acquire() const;
+			void Publish(std::shared_ptr<const FrozenBlock> snapshot);
+			void Publish(const Block &block);
+			// Incremented every time a new snapshot is published
+			uint64_t GetVersion() const;
+		  private:
+			std::atomic<std::shared_ptr<const FrozenBlock>> m_snapshot;
+			std::atomic<uint64_t> m_version = 0;
+		};
+
+		// Per-thread view of a DocumentHandle. The snapshot is cached and only re-acquired if a new version has been published,
+		// so reading an unchanged document only costs a single atomic load of the version counter.
+		// A reader must not be shared between threads, and has to be destroyed before the handle.
+		class DLLDATASYSTEM DocumentReader {
+		  public:
+			DocumentReader(const DocumentHandle &handle);
+			// Returns the current snapshot. The pointer stays valid until the next call to Get or until the reader is destroyed.
+			const FrozenBlock *Get();
+			const FrozenBlock *operator->();
+		  private:
+			const DocumentHandle &m_handle;
+			std::shared_ptr<const FrozenBlock> m_snapshot = nullptr;
+			std::optional<uint64_t> m_version {};
+		};
+	};
+#pragma warning(pop)
+}
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+export module pragma.datasystem:traversal;
+
+export import :asset;
+export import :color;
+export import :core;
+export import :vector;
+
+export {
+#pragma warning(push)
+#pragma warning(disable : 4251)
+	namespace pragma::datasystem {
+		// Depth-first (pre-order) traversal over all entries of a block and its children. Containers are yielded first,
+		// followed by each of their blocks with the same key and a depth one greater. Entries are non-owning and no shared_ptr is copied.
+		class DLLDATASYSTEM DepthFirstRange {
+		  public:
+			struct Entry {
+				const std::string &key;
+				Base &data;
+				uint32_t depth;
+			};
+			class DLLDATASYSTEM Iterator {
+			  public:
+				using iterator_concept = std::input_iterator_tag;
+				using value_type = Entry;
+				using difference_type = std::ptrdiff_t;
+				Iterator() = default;
+				Iterator(const Block &root);
+				Entry operator*() const;
+				Iterator &operator++();
+				void operator++(int);
+				bool operator==(std::default_sentinel_t) const;
+			  private:
+				struct Frame {
+					Block::DataMap::const_iterator it;
+					Block::DataMap::const_iterator end;
+					// Only set for container frames, which iterate over the blocks of the container instead of a data map
+					const Container *container = nullptr;
+					const std::string *containerKey = nullptr;
+					uint32_t containerIndex = 0;
+				};
+				void PushBlock(const Block &block);
+				void SkipExhaustedFrames();
+				std::vector<Frame> m_stack;
+			};
+
+			DepthFirstRange(const Block &root);
+			Iterator begin() const;
+			std::default_sentinel_t end() const;
+		  private:
+			const Block &m_root;
+		};
+		DLLDATASYSTEM DepthFirstRange traverse_depth_first(const Block &block);
+
+		template<class... Ts>
+		struct overloaded : Ts... {
+			using Ts::operator()...;
+		};
+		template<class... Ts>
+		overloaded(Ts...) -> overloaded<Ts...>;
+
+		namespace detail {
+			template<typename TTarget, typename TSource>
+			using copy_const_t = std::conditional_t<std::is_const_v<TSource>, const TTarget, TTarget>;
+			// Only invokes the visitor if it accepts the type, so visitors only have to handle the types they are interested in
+			template<typename T, typename TSource, typename TVisitor, typename... TArgs>
+			void invoke_visitor(TSource &value, TVisitor &visitor, TArgs &...args)
+			{
+				using TCast = copy_const_t<T, TSource>;
+				if constexpr(std::is_invocable_v<TVisitor &, TArgs &..., TCast &>)
+					visitor(args..., static_cast<TCast &>(value));
+			}
+			// GetType can be overridden by user types, so the dynamic type has to be verified before casting. Comparing the type_info
+			// is enough for the built-in types, a dynamic_cast is only required for user types which derive from them.
+			template<typename T, typename TValue, typename TVisitor, typename... TArgs>
+			void invoke_value_visitor(TValue &value, TVisitor &visitor, TArgs &...args)
+			{
+				using TCast = copy_const_t<T, TValue>;
+				auto *ptr = (typeid(value) == typeid(T)) ? static_cast<TCast *>(&value) : dynamic_cast<TCast *>(&value);
+				if(ptr)
+					invoke_visitor<T>(*ptr, visitor, args...);
+				else
+					invoke_visitor<Value>(value, visitor, args...);
+			}
+			template<typename TValue, typename TVisitor, typename... TArgs>
+			void visit_value(TValue &value, TVisitor &visitor, TArgs &...args)
+			{
+				switch(value.GetType()) {
+				case ValueType::String:
+					return invoke_value_visitor<String>(value, visitor, args...);
+				case ValueType::Int:
+					return invoke_value_visitor<Int>(value, visitor, args...);
+				case ValueType::Float:
+					return invoke_value_visitor<Float>(value, visitor, args...);
+				case ValueType::Bool:
+					return invoke_value_visitor<Bool>(value, visitor, args...);
+				case ValueType::Color:
+					return invoke_value_visitor<Color>(value, visitor, args...);
+				case ValueType::Vector2:
+					return invoke_value_visitor<Vector2>(value, visitor, args...);
+				case ValueType::Vector3:
+					return invoke_value_visitor<Vector>(value, visitor, args...);
+				case ValueType::Vector4:
+					return invoke_value_visitor<Vector4>(value, visitor, args...);
+				case ValueType::Texture:
+					return invoke_value_visitor<AssetReference>(value, visitor, args...);
+				default:
+					return invoke_visitor<Value>(value, visitor, args...);
+				}
+			}
+			template<typename TBlock, typename TVisitor>
+			void visit_block(TBlock &block, TVisitor &visitor)
+			{
+				for(auto &pair : *block.GetData()) {
+					auto &data = *pair.second;
+					if(data.IsBlock()) {
+						auto &child = static_cast<copy_const_t<Block, TBlock> &>(data);
+						invoke_visitor<Block>(child, visitor, pair.first);
+						visit_block(child, visitor);
+						continue;
+					}
+					if(data.IsContainer()) {
+						for(auto &child : static_cast<const Container &>(data).GetBlockRange()) {
+							auto &childRef = static_cast<copy_const_t<Block, TBlock> &>(child);
+							invoke_visitor<Block>(childRef, visitor, pair.first);
+							visit_block(childRef, visitor);
+						}
+						continue;
+					}
+					detail::visit_value(static_cast<copy_const_t<Value, TBlock> &>(data), visitor, pair.first);
+				}
+			}
+		};
+
+		// Calls the visitor with the value cast to its concrete type. The type is determined through Value::GetType and verified with a
+		// type_info comparison, values of user-defined types are passed as Value.
+		// Example: visit_value(value, overloaded {[](Int &v) {}, [](String &v) {}});
+		template<typename TValue, typename TVisitor>
+		    requires(std::is_same_v<std::remove_const_t<TValue>, Value>)
+		void visit_value(TValue &value, TVisitor &&visitor)
+		{
+			detail::visit_value(value, visitor);
+		}
+
+		// Visits all entries of the block and its children depth-first. The visitor is called with the key and the concrete type of each entry;
+		// blocks inside containers are passed individually with the key of the container.
+		// Example: visit(block, overloaded {[](const std::string &key, Block &child) {}, [](const std::string &key, Float &v) {}});
+		template<typename TBlock, typename TVisitor>
+		    requires(std::is_same_v<std::remove_const_t<TBlock>, Block>)
+		void visit(TBlock &block, TVisitor &&visitor)
+		{
+			detail::visit_block(block, visitor);
+		}
+	};
+#pragma warning(pop)
+}
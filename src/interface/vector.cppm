@@ -24,6 +24,9 @@ export namespace pragma::datasystem {
 		virtual Vector3 GetVector() const override;
 		virtual ::Vector2 GetVector2() const override;
 		virtual ::Vector4 GetVector4() const override;
+		virtual size_t GetMemoryUsage() const override;
+		virtual uint64_t ContentHash() const override;
+		virtual bool Equals(const Value &other) const override;
 	  private:
 		Vector3 m_value;
 	};
@@ -45,6 +48,9 @@ export namespace pragma::datasystem {
 		virtual Vector3 GetVector() const override;
 		virtual ::Vector2 GetVector2() const override;
 		virtual ::Vector4 GetVector4() const override;
+		virtual size_t GetMemoryUsage() const override;
+		virtual uint64_t ContentHash() const override;
+		virtual bool Equals(const Value &other) const override;
 	  private:
 		::Vector4 m_value;
 	};
@@ -66,6 +72,9 @@ export namespace pragma::datasystem {
 		virtual ::Vector2 GetVector2() const override;
 		virtual Vector3 GetVector() const override;
 		virtual ::Vector4 GetVector4() const override;
+		virtual size_t GetMemoryUsage() const override;
+		virtual uint64_t ContentHash() const override;
+		virtual bool Equals(const Value &other) const override;
 	  private:
 		::Vector2 m_value;
 	};